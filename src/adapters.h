@@ -0,0 +1,787 @@
+#ifndef SRC_ADAPTERS_H_
+#define SRC_ADAPTERS_H_
+
+#include "payload.h"
+
+#include "osc/OscOutboundPacketStream.h"
+#include "osc/OscReceivedElements.h"
+#include "oscpkt.hh"
+#include "oscpp/client.hpp"
+#include "oscpp/server.hpp"
+
+extern "C" {
+#include "lo/lo.h"
+}
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Per-library adapters used as template arguments by the benchmarks. Each adapter provides:
+//
+//   serialize(payload, buffer, capacity) - builds and encodes |payload| the way an application using that library
+//       would, returning the encoded packet size. Libraries that own their output storage ignore |buffer|.
+//   deserialize(packet, size) - parses an encoded packet, returning false if the library rejects it.
+//   consume(packet, size, sink) - parses an encoded packet and reads every argument through the library's own
+//       argument accessors into |sink|, returning false if the library rejects it.
+//   encode(payload) - returns the encoded packet, for benchmark setup outside of the timed loop.
+//   serializeBundle, deserializeBundle, consumeBundle, encodeBundle - the same operations on a BundlePayload. The
+//       bundle decoders walk nested bundles and return the number of messages found, or 0 on error.
+//   typeTags - the type tags the library can encode and decode.
+namespace taposc {
+
+// Accumulates decoded arguments so that argument reads cannot be optimized away.
+struct Sink {
+    int64_t integers = 0;
+    double reals = 0.0;
+    size_t bytes = 0;
+};
+
+template <typename Library>
+bool supports(const Payload& payload) {
+    return payload.typeTags().find_first_not_of(Library::typeTags) == std::string::npos;
+}
+
+struct Liblo {
+    static constexpr const char* typeTags = "ifsbhdtTFNI";
+
+    static size_t serialize(const Payload& payload, char* buffer, size_t /* capacity */) {
+        lo_message message = build(payload);
+        size_t size = 0;
+        lo_message_serialise(message, payload.address(), buffer, &size);
+        lo_message_free(message);
+        return size;
+    }
+
+    static lo_message build(const Payload& payload) {
+        lo_message message = lo_message_new();
+        for (const Argument& argument : payload.arguments()) {
+            switch (argument.tag) {
+            case 'i':
+                lo_message_add_int32(message, argument.i);
+                break;
+            case 'f':
+                lo_message_add_float(message, argument.f);
+                break;
+            case 's':
+                lo_message_add_string(message, argument.s);
+                break;
+            case 'b': {
+                lo_blob blob = lo_blob_new(argument.blobSize, argument.blobData);
+                lo_message_add_blob(message, blob);
+                lo_blob_free(blob);
+            } break;
+            case 'h':
+                lo_message_add_int64(message, argument.h);
+                break;
+            case 'd':
+                lo_message_add_double(message, argument.d);
+                break;
+            case 't':
+                lo_message_add_timetag(message, toTimeTag(argument.t));
+                break;
+            case 'T':
+                lo_message_add_true(message);
+                break;
+            case 'F':
+                lo_message_add_false(message);
+                break;
+            case 'N':
+                lo_message_add_nil(message);
+                break;
+            case 'I':
+                lo_message_add_infinitum(message);
+                break;
+            }
+        }
+        return message;
+    }
+
+    static bool deserialize(const char* packet, size_t size) {
+        lo_message message = lo_message_deserialise(const_cast<char*>(packet), size, nullptr);
+        if (!message) {
+            return false;
+        }
+        lo_message_free(message);
+        return true;
+    }
+
+    static bool consume(const char* packet, size_t size, Sink& sink) {
+        lo_message message = lo_message_deserialise(const_cast<char*>(packet), size, nullptr);
+        if (!message) {
+            return false;
+        }
+        consume(message, sink);
+        lo_message_free(message);
+        return true;
+    }
+
+    static void consume(lo_message message, Sink& sink) {
+        const char* types = lo_message_get_types(message);
+        lo_arg** argv = lo_message_get_argv(message);
+        const int argc = lo_message_get_argc(message);
+        for (int i = 0; i < argc; ++i) {
+            switch (types[i]) {
+            case 'i':
+                sink.integers += argv[i]->i;
+                break;
+            case 'f':
+                sink.reals += argv[i]->f;
+                break;
+            case 's':
+                sink.bytes += std::strlen(&argv[i]->s);
+                break;
+            case 'b':
+                sink.bytes += argv[i]->blob.size;
+                break;
+            case 'h':
+                sink.integers += argv[i]->h;
+                break;
+            case 'd':
+                sink.reals += argv[i]->d;
+                break;
+            case 't':
+                sink.integers += argv[i]->t.sec;
+                break;
+            case 'T':
+                ++sink.integers;
+                break;
+            }
+        }
+    }
+
+    static std::vector<char> encode(const Payload& payload) {
+        std::vector<char> packet(payload.packetSize());
+        packet.resize(serialize(payload, packet.data(), packet.size()));
+        return packet;
+    }
+
+    static size_t serializeBundle(const BundlePayload& bundle, char* buffer, size_t /* capacity */) {
+        const lo_timetag timeTag = toTimeTag(bundle.timeTag());
+        lo_bundle outer = lo_bundle_new(timeTag);
+        lo_bundle inner = outer;
+        const std::vector<Payload>& messages = bundle.messages();
+        for (size_t i = 0; i < messages.size(); ++i) {
+            if (bundle.groupSize() && i % bundle.groupSize() == 0) {
+                inner = lo_bundle_new(timeTag);
+                lo_bundle_add_bundle(outer, inner);
+            }
+            lo_bundle_add_message(inner, messages[i].address(), build(messages[i]));
+        }
+        size_t size = 0;
+        lo_bundle_serialise(outer, buffer, &size);
+        lo_bundle_free_recursive(outer);
+        return size;
+    }
+
+    // liblo only decodes bundles inside lo_server dispatch, so the bundle decoders walk the bundle elements here and
+    // hand each message to lo_message_deserialise, as the server does.
+    static size_t deserializeBundle(const char* packet, size_t size) {
+        return walkBundle(packet, size, nullptr);
+    }
+
+    static size_t consumeBundle(const char* packet, size_t size, Sink& sink) {
+        return walkBundle(packet, size, &sink);
+    }
+
+    static std::vector<char> encodeBundle(const BundlePayload& bundle) {
+        std::vector<char> packet(bundle.packetSize());
+        packet.resize(serializeBundle(bundle, packet.data(), packet.size()));
+        return packet;
+    }
+
+    static lo_timetag toTimeTag(uint64_t timeTag) {
+        lo_timetag result = { static_cast<uint32_t>(timeTag >> 32), static_cast<uint32_t>(timeTag) };
+        return result;
+    }
+
+    static size_t walkBundle(const char* packet, size_t size, Sink* sink) {
+        if (size < 16 || std::memcmp(packet, "#bundle", 8) != 0) {
+            return 0;
+        }
+        size_t messages = 0;
+        const unsigned char* element = reinterpret_cast<const unsigned char*>(packet) + 16;
+        const unsigned char* end = reinterpret_cast<const unsigned char*>(packet) + size;
+        while (element + 4 <= end) {
+            const size_t elementSize = (static_cast<size_t>(element[0]) << 24) | (element[1] << 16) |
+                    (element[2] << 8) | element[3];
+            const char* contents = reinterpret_cast<const char*>(element + 4);
+            if (elementSize > static_cast<size_t>(end - element - 4)) {
+                return 0;
+            }
+            if (elementSize && contents[0] == '#') {
+                const size_t inner = walkBundle(contents, elementSize, sink);
+                if (!inner) {
+                    return 0;
+                }
+                messages += inner;
+            } else {
+                lo_message message = lo_message_deserialise(const_cast<char*>(contents), elementSize, nullptr);
+                if (!message) {
+                    return 0;
+                }
+                if (sink) {
+                    consume(message, *sink);
+                }
+                lo_message_free(message);
+                ++messages;
+            }
+            element += 4 + elementSize;
+        }
+        return messages;
+    }
+};
+
+struct Oscpack {
+    static constexpr const char* typeTags = "ifsbhdtTFNI[]";
+
+    static size_t serialize(const Payload& payload, char* buffer, size_t capacity) {
+        osc::OutboundPacketStream p(buffer, capacity);
+        build(payload, p);
+        return p.Size();
+    }
+
+    static void build(const Payload& payload, osc::OutboundPacketStream& p) {
+        p << osc::BeginMessage(payload.address());
+        for (const Argument& argument : payload.arguments()) {
+            switch (argument.tag) {
+            case 'i':
+                p << static_cast<osc::int32>(argument.i);
+                break;
+            case 'f':
+                p << argument.f;
+                break;
+            case 's':
+                p << argument.s;
+                break;
+            case 'b':
+                p << osc::Blob(argument.blobData, argument.blobSize);
+                break;
+            case 'h':
+                p << static_cast<osc::int64>(argument.h);
+                break;
+            case 'd':
+                p << argument.d;
+                break;
+            case 't':
+                p << osc::TimeTag(argument.t);
+                break;
+            case 'T':
+                p << true;
+                break;
+            case 'F':
+                p << false;
+                break;
+            case 'N':
+                p << osc::OscNil;
+                break;
+            case 'I':
+                p << osc::Infinitum;
+                break;
+            case '[':
+                p << osc::BeginArray;
+                break;
+            case ']':
+                p << osc::EndArray;
+                break;
+            }
+        }
+        p << osc::EndMessage;
+    }
+
+    static bool deserialize(const char* packet, size_t size) {
+        osc::ReceivedPacket message(packet, size);
+        return message.IsMessage();
+    }
+
+    static bool consume(const char* packet, size_t size, Sink& sink) {
+        try {
+            osc::ReceivedPacket receivedPacket(packet, size);
+            if (!receivedPacket.IsMessage()) {
+                return false;
+            }
+            consume(osc::ReceivedMessage(receivedPacket), sink);
+        } catch (const osc::Exception&) {
+            return false;
+        }
+        return true;
+    }
+
+    static void consume(const osc::ReceivedMessage& message, Sink& sink) {
+        for (auto argument = message.ArgumentsBegin(); argument != message.ArgumentsEnd(); ++argument) {
+            switch (argument->TypeTag()) {
+            case osc::INT32_TYPE_TAG:
+                sink.integers += argument->AsInt32Unchecked();
+                break;
+            case osc::FLOAT_TYPE_TAG:
+                sink.reals += argument->AsFloatUnchecked();
+                break;
+            case osc::STRING_TYPE_TAG:
+                sink.bytes += std::strlen(argument->AsStringUnchecked());
+                break;
+            case osc::BLOB_TYPE_TAG: {
+                const void* data = nullptr;
+                osc::osc_bundle_element_size_t blobSize = 0;
+                argument->AsBlobUnchecked(data, blobSize);
+                sink.bytes += blobSize;
+            } break;
+            case osc::INT64_TYPE_TAG:
+                sink.integers += argument->AsInt64Unchecked();
+                break;
+            case osc::DOUBLE_TYPE_TAG:
+                sink.reals += argument->AsDoubleUnchecked();
+                break;
+            case osc::TIME_TAG_TYPE_TAG:
+                sink.integers += argument->AsTimeTagUnchecked() >> 32;
+                break;
+            case osc::TRUE_TYPE_TAG:
+                ++sink.integers;
+                break;
+            }
+        }
+    }
+
+    static std::vector<char> encode(const Payload& payload) {
+        std::vector<char> packet(payload.packetSize());
+        packet.resize(serialize(payload, packet.data(), packet.size()));
+        return packet;
+    }
+
+    static size_t serializeBundle(const BundlePayload& bundle, char* buffer, size_t capacity) {
+        osc::OutboundPacketStream p(buffer, capacity);
+        p << osc::BeginBundle(bundle.timeTag());
+        const std::vector<Payload>& messages = bundle.messages();
+        for (size_t i = 0; i < messages.size(); ++i) {
+            if (bundle.groupSize() && i % bundle.groupSize() == 0) {
+                if (i) {
+                    p << osc::EndBundle;
+                }
+                p << osc::BeginBundle(bundle.timeTag());
+            }
+            build(messages[i], p);
+        }
+        if (bundle.groupSize() && messages.size()) {
+            p << osc::EndBundle;
+        }
+        p << osc::EndBundle;
+        return p.Size();
+    }
+
+    static size_t deserializeBundle(const char* packet, size_t size) {
+        return walkBundle(packet, size, nullptr);
+    }
+
+    static size_t consumeBundle(const char* packet, size_t size, Sink& sink) {
+        return walkBundle(packet, size, &sink);
+    }
+
+    static std::vector<char> encodeBundle(const BundlePayload& bundle) {
+        std::vector<char> packet(bundle.packetSize());
+        packet.resize(serializeBundle(bundle, packet.data(), packet.size()));
+        return packet;
+    }
+
+    static size_t walkBundle(const char* packet, size_t size, Sink* sink) {
+        try {
+            osc::ReceivedPacket receivedPacket(packet, size);
+            if (!receivedPacket.IsBundle()) {
+                return 0;
+            }
+            return walkBundle(osc::ReceivedBundle(receivedPacket), sink);
+        } catch (const osc::Exception&) {
+            return 0;
+        }
+    }
+
+    static size_t walkBundle(const osc::ReceivedBundle& bundle, Sink* sink) {
+        size_t messages = 0;
+        for (auto element = bundle.ElementsBegin(); element != bundle.ElementsEnd(); ++element) {
+            if (element->IsBundle()) {
+                messages += walkBundle(osc::ReceivedBundle(*element), sink);
+            } else {
+                osc::ReceivedMessage message(*element);
+                if (sink) {
+                    consume(message, *sink);
+                }
+                ++messages;
+            }
+        }
+        return messages;
+    }
+};
+
+struct Oscpkt {
+    static constexpr const char* typeTags = "ifsbhdTF";
+
+    static size_t serialize(const Payload& payload, char* /* buffer */, size_t /* capacity */) {
+        oscpkt::Message message(payload.address());
+        build(payload, message);
+        oscpkt::PacketWriter pw;
+        pw.addMessage(message);
+        return pw.packetSize();
+    }
+
+    static bool deserialize(const char* packet, size_t size) {
+        oscpkt::PacketReader reader(packet, size);
+        return reader.isOk();
+    }
+
+    static bool consume(const char* packet, size_t size, Sink& sink) {
+        oscpkt::PacketReader reader(packet, size);
+        oscpkt::Message* message = reader.popMessage();
+        if (!message) {
+            return false;
+        }
+        consume(*message, sink);
+        return true;
+    }
+
+    static void consume(const oscpkt::Message& message, Sink& sink) {
+        oscpkt::Message::ArgReader arg = message.arg();
+        while (arg.nbArgRemaining() && arg.isOk()) {
+            if (arg.isInt32()) {
+                int32_t i;
+                arg.popInt32(i);
+                sink.integers += i;
+            } else if (arg.isFloat()) {
+                float f;
+                arg.popFloat(f);
+                sink.reals += f;
+            } else if (arg.isStr()) {
+                std::string s;
+                arg.popStr(s);
+                sink.bytes += s.size();
+            } else if (arg.isBlob()) {
+                std::vector<char> b;
+                arg.popBlob(b);
+                sink.bytes += b.size();
+            } else if (arg.isInt64()) {
+                int64_t h;
+                arg.popInt64(h);
+                sink.integers += h;
+            } else if (arg.isDouble()) {
+                double d;
+                arg.popDouble(d);
+                sink.reals += d;
+            } else if (arg.isBool()) {
+                bool b;
+                arg.popBool(b);
+                sink.integers += b;
+            } else {
+                arg.pop();
+            }
+        }
+    }
+
+    static std::vector<char> encode(const Payload& payload) {
+        oscpkt::Message message(payload.address());
+        build(payload, message);
+        oscpkt::PacketWriter pw;
+        pw.addMessage(message);
+        return std::vector<char>(pw.packetData(), pw.packetData() + pw.packetSize());
+    }
+
+    static size_t serializeBundle(const BundlePayload& bundle, char* /* buffer */, size_t /* capacity */) {
+        oscpkt::PacketWriter pw;
+        buildBundle(bundle, pw);
+        return pw.packetSize();
+    }
+
+    static size_t deserializeBundle(const char* packet, size_t size) {
+        oscpkt::PacketReader reader(packet, size);
+        size_t messages = 0;
+        while (reader.popMessage()) {
+            ++messages;
+        }
+        return reader.isOk() ? messages : 0;
+    }
+
+    static size_t consumeBundle(const char* packet, size_t size, Sink& sink) {
+        oscpkt::PacketReader reader(packet, size);
+        size_t messages = 0;
+        while (oscpkt::Message* message = reader.popMessage()) {
+            consume(*message, sink);
+            ++messages;
+        }
+        return reader.isOk() ? messages : 0;
+    }
+
+    static std::vector<char> encodeBundle(const BundlePayload& bundle) {
+        oscpkt::PacketWriter pw;
+        buildBundle(bundle, pw);
+        return std::vector<char>(pw.packetData(), pw.packetData() + pw.packetSize());
+    }
+
+    static void buildBundle(const BundlePayload& bundle, oscpkt::PacketWriter& pw) {
+        oscpkt::Message message;
+        const oscpkt::TimeTag timeTag(bundle.timeTag());
+        pw.startBundle(timeTag);
+        const std::vector<Payload>& messages = bundle.messages();
+        for (size_t i = 0; i < messages.size(); ++i) {
+            if (bundle.groupSize() && i % bundle.groupSize() == 0) {
+                if (i) {
+                    pw.endBundle();
+                }
+                pw.startBundle(timeTag);
+            }
+            message.init(messages[i].address(), timeTag);
+            build(messages[i], message);
+            pw.addMessage(message);
+        }
+        if (bundle.groupSize() && messages.size()) {
+            pw.endBundle();
+        }
+        pw.endBundle();
+    }
+
+    static void build(const Payload& payload, oscpkt::Message& message) {
+        for (const Argument& argument : payload.arguments()) {
+            switch (argument.tag) {
+            case 'i':
+                message.pushInt32(argument.i);
+                break;
+            case 'f':
+                message.pushFloat(argument.f);
+                break;
+            case 's':
+                message.pushStr(argument.s);
+                break;
+            case 'b':
+                message.pushBlob(const_cast<char*>(argument.blobData), argument.blobSize);
+                break;
+            case 'h':
+                message.pushInt64(argument.h);
+                break;
+            case 'd':
+                message.pushDouble(argument.d);
+                break;
+            case 'T':
+                message.pushBool(true);
+                break;
+            case 'F':
+                message.pushBool(false);
+                break;
+            }
+        }
+    }
+};
+
+// oscpkt decoding through PacketReaderView, which reads messages in place instead of copying each one into a
+// Message. Strings and blobs are consumed as pointers into the packet. Encoding is the same as Oscpkt.
+struct OscpktView : Oscpkt {
+    static bool deserialize(const char* packet, size_t size) {
+        oscpkt::PacketReaderView reader(packet, size);
+        return reader.isOk();
+    }
+
+    static bool consume(const char* packet, size_t size, Sink& sink) {
+        oscpkt::PacketReaderView reader(packet, size);
+        oscpkt::MessageView* message = reader.popMessage();
+        if (!message) {
+            return false;
+        }
+        consume(*message, sink);
+        return true;
+    }
+
+    static void consume(const oscpkt::MessageView& message, Sink& sink) {
+        oscpkt::MessageView::ArgReader arg = message.arg();
+        while (arg.nbArgRemaining() && arg.isOk()) {
+            if (arg.isInt32()) {
+                int32_t i;
+                arg.popInt32(i);
+                sink.integers += i;
+            } else if (arg.isFloat()) {
+                float f;
+                arg.popFloat(f);
+                sink.reals += f;
+            } else if (arg.isStr()) {
+                const char* s = "";
+                arg.popStr(s);
+                sink.bytes += std::strlen(s);
+            } else if (arg.isBlob()) {
+                const void* data = nullptr;
+                size_t size = 0;
+                arg.popBlob(data, size);
+                sink.bytes += size;
+            } else if (arg.isInt64()) {
+                int64_t h;
+                arg.popInt64(h);
+                sink.integers += h;
+            } else if (arg.isDouble()) {
+                double d;
+                arg.popDouble(d);
+                sink.reals += d;
+            } else if (arg.isBool()) {
+                bool b;
+                arg.popBool(b);
+                sink.integers += b;
+            } else {
+                arg.pop();
+            }
+        }
+    }
+
+    static size_t deserializeBundle(const char* packet, size_t size) {
+        oscpkt::PacketReaderView reader(packet, size);
+        size_t messages = 0;
+        while (reader.popMessage()) {
+            ++messages;
+        }
+        return reader.isOk() ? messages : 0;
+    }
+
+    static size_t consumeBundle(const char* packet, size_t size, Sink& sink) {
+        oscpkt::PacketReaderView reader(packet, size);
+        size_t messages = 0;
+        while (oscpkt::MessageView* message = reader.popMessage()) {
+            consume(*message, sink);
+            ++messages;
+        }
+        return reader.isOk() ? messages : 0;
+    }
+};
+
+struct Oscpp {
+    static constexpr const char* typeTags = "ifsb[]";
+
+    static size_t serialize(const Payload& payload, char* buffer, size_t capacity) {
+        OSCPP::Client::Packet packet(buffer, capacity);
+        build(payload, packet);
+        return packet.size();
+    }
+
+    static void build(const Payload& payload, OSCPP::Client::Packet& packet) {
+        packet.openMessage(payload.address(), payload.typeTags().size());
+        for (const Argument& argument : payload.arguments()) {
+            switch (argument.tag) {
+            case 'i':
+                packet.int32(argument.i);
+                break;
+            case 'f':
+                packet.float32(argument.f);
+                break;
+            case 's':
+                packet.string(argument.s);
+                break;
+            case 'b':
+                packet.blob(OSCPP::Blob(argument.blobData, argument.blobSize));
+                break;
+            case '[':
+                packet.openArray();
+                break;
+            case ']':
+                packet.closeArray();
+                break;
+            }
+        }
+        packet.closeMessage();
+    }
+
+    static bool deserialize(const char* packet, size_t size) {
+        OSCPP::Server::Packet serverPacket(packet, size);
+        OSCPP::Server::Message message(serverPacket);
+        return serverPacket.isMessage();
+    }
+
+    static bool consume(const char* packet, size_t size, Sink& sink) {
+        OSCPP::Server::Packet serverPacket(packet, size);
+        if (!serverPacket.isMessage()) {
+            return false;
+        }
+        OSCPP::Server::Message message(serverPacket);
+        consume(message.args(), sink);
+        return true;
+    }
+
+    static void consume(OSCPP::Server::ArgStream args, Sink& sink) {
+        while (!args.atEnd()) {
+            switch (args.tag()) {
+            case 'i':
+                sink.integers += args.int32();
+                break;
+            case 'f':
+                sink.reals += args.float32();
+                break;
+            case 's':
+                sink.bytes += std::strlen(args.string());
+                break;
+            case 'b':
+                sink.bytes += args.blob().size;
+                break;
+            case '[':
+                consume(args.array(), sink);
+                break;
+            default:
+                args.drop();
+                break;
+            }
+        }
+    }
+
+    static std::vector<char> encode(const Payload& payload) {
+        std::vector<char> packet(payload.packetSize());
+        packet.resize(serialize(payload, packet.data(), packet.size()));
+        return packet;
+    }
+
+    static size_t serializeBundle(const BundlePayload& bundle, char* buffer, size_t capacity) {
+        OSCPP::Client::Packet packet(buffer, capacity);
+        packet.openBundle(bundle.timeTag());
+        const std::vector<Payload>& messages = bundle.messages();
+        for (size_t i = 0; i < messages.size(); ++i) {
+            if (bundle.groupSize() && i % bundle.groupSize() == 0) {
+                if (i) {
+                    packet.closeBundle();
+                }
+                packet.openBundle(bundle.timeTag());
+            }
+            build(messages[i], packet);
+        }
+        if (bundle.groupSize() && messages.size()) {
+            packet.closeBundle();
+        }
+        packet.closeBundle();
+        return packet.size();
+    }
+
+    static size_t deserializeBundle(const char* packet, size_t size) {
+        OSCPP::Server::Packet serverPacket(packet, size);
+        return serverPacket.isBundle() ? walkBundle(serverPacket, nullptr) : 0;
+    }
+
+    static size_t consumeBundle(const char* packet, size_t size, Sink& sink) {
+        OSCPP::Server::Packet serverPacket(packet, size);
+        return serverPacket.isBundle() ? walkBundle(serverPacket, &sink) : 0;
+    }
+
+    static std::vector<char> encodeBundle(const BundlePayload& bundle) {
+        std::vector<char> packet(bundle.packetSize());
+        packet.resize(serializeBundle(bundle, packet.data(), packet.size()));
+        return packet;
+    }
+
+    static size_t walkBundle(const OSCPP::Server::Packet& packet, Sink* sink) {
+        size_t messages = 0;
+        OSCPP::Server::PacketStream elements(OSCPP::Server::Bundle(packet).packets());
+        while (!elements.atEnd()) {
+            OSCPP::Server::Packet element = elements.next();
+            if (element.isBundle()) {
+                messages += walkBundle(element, sink);
+            } else {
+                OSCPP::Server::Message message(element);
+                if (sink) {
+                    consume(message.args(), *sink);
+                }
+                ++messages;
+            }
+        }
+        return messages;
+    }
+};
+
+} // namespace taposc
+
+#endif // SRC_ADAPTERS_H_
@@ -0,0 +1,89 @@
+#include "addresses.h"
+
+#include <random>
+
+namespace {
+
+struct Area {
+    const char* name;
+    const char* group;
+    const char* params[5];
+};
+
+const Area kAreas[] = {
+    {"mixer", "ch", {"fader", "pan", "mute", "gain", "solo"}},
+    {"light", "fixture", {"dimmer", "rgb", "strobe", "pan", "tilt"}},
+    {"cue", "list", {"go", "stop", "load", "fade", "next"}},
+    {"sensor", "imu", {"frame", "accel", "gyro", "mag", "temp"}},
+    {"device", "unit", {"state", "power", "reset", "name", "level"}},
+    {"fx", "rack", {"mix", "time", "feedback", "bypass", "preset"}},
+};
+const size_t kAreaCount = sizeof(kAreas) / sizeof(kAreas[0]);
+const size_t kParamCount = 5;
+
+} // namespace
+
+namespace taposc {
+
+std::string makeAddress(size_t index) {
+    const Area& area = kAreas[index % kAreaCount];
+    const size_t param = index / kAreaCount % kParamCount;
+    const size_t number = index / (kAreaCount * kParamCount);
+    return std::string("/") + area.name + "/" + area.group + "/" + std::to_string(number) + "/" + area.params[param];
+}
+
+std::vector<std::string> makeTraffic(size_t space, size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> pick(0, space - 1);
+    std::vector<std::string> traffic;
+    traffic.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        traffic.push_back(makeAddress(pick(rng)));
+    }
+    return traffic;
+}
+
+std::vector<std::string> makeHandlerPatterns(size_t count, int wildcardPercent, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::vector<std::string> patterns;
+    patterns.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (percent(rng) >= wildcardPercent) {
+            patterns.push_back(makeAddress(i));
+            continue;
+        }
+        const Area& area = kAreas[i % kAreaCount];
+        const size_t param = i / kAreaCount % kParamCount;
+        std::string number = std::to_string(i / (kAreaCount * kParamCount));
+        std::string prefix = std::string("/") + area.name + "/" + area.group + "/";
+        switch (rng() % 5) {
+        case 0:
+            // Every channel: "/mixer/ch/*/fader".
+            patterns.push_back(prefix + "*/" + area.params[param]);
+            break;
+        case 1:
+            // A block of ten channels: "/mixer/ch/1?/fader".
+            number.back() = '?';
+            patterns.push_back(prefix + number + "/" + area.params[param]);
+            break;
+        case 2:
+            // The same block as a class: "/mixer/ch/1[0-9]/fader".
+            number.back() = '[';
+            patterns.push_back(prefix + number + "0-9]/" + area.params[param]);
+            break;
+        case 3:
+            // Two parameters of one channel: "/mixer/ch/12/{fader,pan}".
+            patterns.push_back(prefix + number + "/{" + area.params[param] + "," +
+                    area.params[(param + 1) % kParamCount] + "}");
+            break;
+        default:
+            // A parameter at any depth within an area: "/mixer//fader".
+            patterns.push_back(std::string("/") + area.name + "//" + area.params[param]);
+            break;
+        }
+    }
+    return patterns;
+}
+
+} // namespace taposc
@@ -0,0 +1,25 @@
+#ifndef SRC_ADDRESSES_H_
+#define SRC_ADDRESSES_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Synthetic OSC address spaces for the routing benchmarks, shaped like a show-control namespace:
+// "/mixer/ch/12/fader", "/light/fixture/3/dimmer" and so on. Address i is unique for every i, so spaces of any size
+// can be built.
+namespace taposc {
+
+std::string makeAddress(size_t index);
+
+// |count| addresses drawn at random from the first |space| addresses.
+std::vector<std::string> makeTraffic(size_t space, size_t count, uint32_t seed);
+
+// One handler pattern per address of a space of |count| addresses. About |wildcardPercent| of them have a segment
+// replaced with a wildcard: '*', '?', a bracketed class, a braced list or a leading "//".
+std::vector<std::string> makeHandlerPatterns(size_t count, int wildcardPercent, uint32_t seed);
+
+} // namespace taposc
+
+#endif // SRC_ADDRESSES_H_
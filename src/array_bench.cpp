@@ -0,0 +1,131 @@
+#include "bench.h"
+
+#include "osc/OscOutboundPacketStream.h"
+#include "osc/OscReceivedElements.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Encoding and decoding one message of N int32 or float arguments with oscpack, as in a spectrum frame. PerValue
+// streams each value through operator<< and operator>>, which checks space, writes a type tag and byte-swaps one
+// value at a time. Bulk uses OutboundPacketStream::Append*Array and ReceivedMessageArgumentStream::Read*Array, which
+// do each of those once for the whole array.
+
+namespace {
+
+const char* const kAddress = "/analysis/spectrum";
+
+void elementSweep(benchmark::internal::Benchmark* b) {
+    b->ArgName("elements")->Arg(16)->Arg(512)->Arg(4096);
+}
+
+struct PerValue {
+    template <typename T>
+    static void append(osc::OutboundPacketStream& p, const T* values, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            p << values[i];
+        }
+    }
+
+    template <typename T>
+    static void read(osc::ReceivedMessageArgumentStream& args, T* values, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            args >> values[i];
+        }
+    }
+};
+
+struct Bulk {
+    static void append(osc::OutboundPacketStream& p, const osc::int32* values, size_t count) {
+        p.AppendInt32Array(values, count);
+    }
+
+    static void append(osc::OutboundPacketStream& p, const float* values, size_t count) {
+        p.AppendFloatArray(values, count);
+    }
+
+    static void read(osc::ReceivedMessageArgumentStream& args, osc::int32* values, size_t count) {
+        args.ReadInt32Array(values, count);
+    }
+
+    static void read(osc::ReceivedMessageArgumentStream& args, float* values, size_t count) {
+        args.ReadFloatArray(values, count);
+    }
+};
+
+template <typename T>
+std::vector<T> makeValues(size_t count) {
+    std::vector<T> values(count);
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = static_cast<T>(i * 7919 % 65536) / static_cast<T>(3);
+    }
+    return values;
+}
+
+template <typename T>
+size_t encode(const std::vector<T>& values, char* buffer, size_t capacity) {
+    osc::OutboundPacketStream p(buffer, capacity);
+    p << osc::BeginMessage(kAddress);
+    PerValue::append(p, values.data(), values.size());
+    p << osc::EndMessage;
+    return p.Size();
+}
+
+} // namespace
+
+template <typename Method, typename T>
+static void BM_oscpack_append_array(benchmark::State& state) {
+    const std::vector<T> values = makeValues<T>(state.range(0));
+    std::vector<char> buffer(64 + 5 * values.size());
+    std::vector<char> expected(buffer.size());
+    const size_t expectedSize = encode(values, expected.data(), expected.size());
+
+    size_t size = 0;
+    HeapMeter heap;
+    for (auto _ : state) {
+        osc::OutboundPacketStream p(buffer.data(), buffer.size());
+        p << osc::BeginMessage(kAddress);
+        Method::append(p, values.data(), values.size());
+        p << osc::EndMessage;
+        size = p.Size();
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    heap.report(state);
+    if (size != expectedSize || !std::equal(buffer.begin(), buffer.begin() + size, expected.begin())) {
+        state.SkipWithError("encoding mismatch!");
+    }
+    setThroughput(state, size, 1);
+}
+
+template <typename Method, typename T>
+static void BM_oscpack_read_array(benchmark::State& state) {
+    const std::vector<T> values = makeValues<T>(state.range(0));
+    std::vector<char> buffer(64 + 5 * values.size());
+    buffer.resize(encode(values, buffer.data(), buffer.size()));
+    std::vector<T> decoded(values.size());
+
+    HeapMeter heap;
+    for (auto _ : state) {
+        osc::ReceivedMessage message(osc::ReceivedPacket(buffer.data(), buffer.size()));
+        osc::ReceivedMessageArgumentStream args = message.ArgumentStream();
+        Method::read(args, decoded.data(), decoded.size());
+        args >> osc::EndMessage;
+        benchmark::DoNotOptimize(decoded.data());
+    }
+    heap.report(state);
+    if (decoded != values) {
+        state.SkipWithError("decoding mismatch!");
+    }
+    setThroughput(state, buffer.size(), 1);
+}
+
+BENCHMARK_TEMPLATE(BM_oscpack_append_array, PerValue, osc::int32)->Apply(elementSweep);
+BENCHMARK_TEMPLATE(BM_oscpack_append_array, Bulk, osc::int32)->Apply(elementSweep);
+BENCHMARK_TEMPLATE(BM_oscpack_append_array, PerValue, float)->Apply(elementSweep);
+BENCHMARK_TEMPLATE(BM_oscpack_append_array, Bulk, float)->Apply(elementSweep);
+
+BENCHMARK_TEMPLATE(BM_oscpack_read_array, PerValue, osc::int32)->Apply(elementSweep);
+BENCHMARK_TEMPLATE(BM_oscpack_read_array, Bulk, osc::int32)->Apply(elementSweep);
+BENCHMARK_TEMPLATE(BM_oscpack_read_array, PerValue, float)->Apply(elementSweep);
+BENCHMARK_TEMPLATE(BM_oscpack_read_array, Bulk, float)->Apply(elementSweep);
@@ -0,0 +1,210 @@
+#ifndef SRC_BENCH_H_
+#define SRC_BENCH_H_
+
+#include "benchmark/benchmark.h"
+
+#include "corpus.h"
+#include "heap.h"
+#include "histogram.h"
+#include "payload.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+// Shared by the benchmark translation units: payload shapes and throughput reporting.
+
+using taposc::BundlePayload;
+using taposc::Payload;
+
+// Payload shapes. Each shape builds the message for one benchmark instance from the instance arguments, and
+// registers the argument sweep it runs over.
+
+struct Empty {
+    static Payload make(benchmark::State&) {
+        return Payload("/seriaize");
+    }
+
+    static void sweep(benchmark::internal::Benchmark*) {}
+};
+
+struct Int32Series {
+    static Payload make(benchmark::State& state) {
+        Payload payload("/seriaize");
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            payload.addInt32(static_cast<int32_t>(i));
+        }
+        return payload;
+    }
+
+    static void sweep(benchmark::internal::Benchmark* b) {
+        b->ArgName("args")->RangeMultiplier(4)->Range(1, 4096);
+    }
+};
+
+struct FloatSeries {
+    static Payload make(benchmark::State& state) {
+        Payload payload("/seriaize");
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            payload.addFloat(static_cast<float>(i));
+        }
+        return payload;
+    }
+
+    static void sweep(benchmark::internal::Benchmark* b) {
+        b->ArgName("args")->RangeMultiplier(4)->Range(1, 4096);
+    }
+};
+
+struct String {
+    static Payload make(benchmark::State& state) {
+        Payload payload("/seriaize");
+        payload.addString(state.range(0));
+        return payload;
+    }
+
+    static void sweep(benchmark::internal::Benchmark* b) {
+        b->ArgName("length")->RangeMultiplier(4)->Range(1, 4096);
+    }
+};
+
+struct Blob {
+    static Payload make(benchmark::State& state) {
+        Payload payload("/seriaize");
+        payload.addBlob(state.range(0));
+        return payload;
+    }
+
+    static void sweep(benchmark::internal::Benchmark* b) {
+        b->ArgName("size")->Arg(0)->RangeMultiplier(8)->Range(8, 64 << 10);
+    }
+};
+
+// Cycles through "ifsb" for the requested number of arguments, with the given string length and blob size. The
+// larger instances land in the 1-2 KiB range typical of mixed control traffic.
+struct Mixed {
+    static Payload make(benchmark::State& state) {
+        Payload payload("/seriaize");
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            switch (i % 4) {
+            case 0:
+                payload.addInt32(static_cast<int32_t>(i));
+                break;
+            case 1:
+                payload.addFloat(static_cast<float>(i));
+                break;
+            case 2:
+                payload.addString(state.range(1));
+                break;
+            case 3:
+                payload.addBlob(state.range(2));
+                break;
+            }
+        }
+        return payload;
+    }
+
+    static void sweep(benchmark::internal::Benchmark* b) {
+        b->ArgNames({"args", "length", "size"});
+        for (int64_t count : {4, 16, 64, 256}) {
+            b->Args({count, 8, 16});
+            b->Args({count, 32, 64});
+        }
+    }
+};
+
+// Heterogeneous messages from the corpus, labeled with the message name. Libraries that cannot encode every type tag
+// of a message skip it.
+struct Corpus {
+    static Payload make(benchmark::State& state) {
+        state.SetLabel(taposc::corpusName(state.range(0)));
+        return taposc::makeCorpusMessage(state.range(0));
+    }
+
+    static void sweep(benchmark::internal::Benchmark* b) {
+        b->ArgName("message")->DenseRange(0, taposc::corpusSize() - 1);
+    }
+};
+
+// Bundle shapes, over the 10-200 message range of show-control cue bundles. Every message is a small "ifs" cue update
+// with its own address.
+
+inline BundlePayload makeCueBundle(int64_t count, size_t groupSize) {
+    BundlePayload bundle(0xDA5F6E7A00000000ull, groupSize);
+    for (int64_t i = 0; i < count; ++i) {
+        Payload message(("/show/cue/" + std::to_string(i)).c_str());
+        message.addInt32(static_cast<int32_t>(i));
+        message.addFloat(0.5f);
+        message.addString(8);
+        bundle.addMessage(std::move(message));
+    }
+    return bundle;
+}
+
+struct FlatBundle {
+    static BundlePayload make(benchmark::State& state) {
+        return makeCueBundle(state.range(0), 0);
+    }
+
+    static void sweep(benchmark::internal::Benchmark* b) {
+        b->ArgName("messages")->Arg(10)->Arg(50)->Arg(200);
+    }
+};
+
+// Groups every ten messages into an inner bundle.
+struct NestedBundle {
+    static BundlePayload make(benchmark::State& state) {
+        return makeCueBundle(state.range(0), 10);
+    }
+
+    static void sweep(benchmark::internal::Benchmark* b) {
+        b->ArgName("messages")->Arg(10)->Arg(50)->Arg(200);
+    }
+};
+
+// Reports items/s and bytes/s from the encoded packet, and the packet size itself as a counter so that libraries
+// producing larger encodings of the same payload stand out. The packet size is averaged over threads, since Google
+// Benchmark sums the counters of multithreaded runs.
+inline void setThroughput(benchmark::State& state, size_t packetSize, size_t items) {
+    state.SetItemsProcessed(state.iterations() * items);
+    state.SetBytesProcessed(state.iterations() * packetSize);
+    state.counters["packet_bytes"] =
+            benchmark::Counter(static_cast<double>(packetSize), benchmark::Counter::kAvgThreads);
+}
+
+// Measures the heap traffic of the benchmark thread between construction and report(). Construct it immediately before
+// the timed loop so that setup allocations are excluded.
+class HeapMeter {
+public:
+    HeapMeter() {
+        taposc::resetHeapPeak();
+        m_start = taposc::heapStats();
+    }
+
+    // Sets allocs/op and heap_bytes/op, averaged over iterations, and peak_heap_bytes, the most memory held at once
+    // above what was live when the meter started, averaged over threads.
+    void report(benchmark::State& state) const {
+        const taposc::HeapStats end = taposc::heapStats();
+        state.counters["allocs/op"] = benchmark::Counter(
+                static_cast<double>(end.allocations - m_start.allocations), benchmark::Counter::kAvgIterations);
+        state.counters["heap_bytes/op"] = benchmark::Counter(
+                static_cast<double>(end.bytes - m_start.bytes), benchmark::Counter::kAvgIterations);
+        state.counters["peak_heap_bytes"] = benchmark::Counter(
+                static_cast<double>(end.peakLiveBytes - m_start.liveBytes), benchmark::Counter::kAvgThreads);
+    }
+
+private:
+    taposc::HeapStats m_start;
+};
+
+// Sets p50_ns, p90_ns, p99_ns, p99.9_ns and max_ns from per-operation timings.
+inline void setLatency(benchmark::State& state, const taposc::LatencyHistogram& histogram) {
+    state.counters["p50_ns"] = static_cast<double>(histogram.percentile(50.0));
+    state.counters["p90_ns"] = static_cast<double>(histogram.percentile(90.0));
+    state.counters["p99_ns"] = static_cast<double>(histogram.percentile(99.0));
+    state.counters["p99.9_ns"] = static_cast<double>(histogram.percentile(99.9));
+    state.counters["max_ns"] = static_cast<double>(histogram.max());
+}
+
+#endif // SRC_BENCH_H_
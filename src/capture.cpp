@@ -0,0 +1,200 @@
+#include "capture.h"
+
+#include "histogram.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+const char kFileMagic[8] = {'T', 'A', 'P', 'O', 'S', 'C', 'A', 'P'};
+const char kIndexMagic[8] = {'T', 'A', 'P', 'O', 'S', 'C', 'I', 'X'};
+const uint32_t kVersion = 1;
+
+const size_t kHeaderSize = 16;
+const size_t kRecordHeaderSize = 20;
+const size_t kTrailerSize = 24;
+
+size_t padded(size_t size) {
+    return (size + 3) & ~size_t(3);
+}
+
+void putLittleEndian(char* out, uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        out[i] = static_cast<char>(value >> (8 * i));
+    }
+}
+
+uint64_t getLittleEndian(const char* in, size_t bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+    }
+    return value;
+}
+
+} // namespace
+
+namespace taposc {
+
+CaptureWriter::CaptureWriter(const std::string& path) : m_file(std::fopen(path.c_str(), "wb")) {
+    if (!m_file) {
+        throw std::runtime_error("cannot create capture " + path);
+    }
+    char header[kHeaderSize] = {};
+    std::memcpy(header, kFileMagic, sizeof(kFileMagic));
+    putLittleEndian(header + 8, kVersion, 4);
+    append(header, sizeof(header));
+}
+
+CaptureWriter::~CaptureWriter() {
+    try {
+        close();
+    } catch (const std::exception&) {
+    }
+}
+
+void CaptureWriter::append(const void* data, size_t size) {
+    if (std::fwrite(data, 1, size, m_file) != size) {
+        throw std::runtime_error("capture write failed");
+    }
+    m_offset += size;
+}
+
+void CaptureWriter::write(int64_t timeNs, const char* data, size_t size, const IpEndpointName& remoteEndpoint) {
+    if (!m_file) {
+        throw std::runtime_error("capture already closed");
+    }
+    char header[kRecordHeaderSize] = {};
+    putLittleEndian(header, static_cast<uint64_t>(timeNs), 8);
+    putLittleEndian(header + 8, size, 4);
+    putLittleEndian(header + 12, remoteEndpoint.address, 4);
+    putLittleEndian(header + 16, static_cast<uint16_t>(remoteEndpoint.port), 2);
+
+    m_offsets.push_back(m_offset);
+    append(header, sizeof(header));
+    append(data, size);
+    const char zeros[3] = {};
+    append(zeros, padded(size) - size);
+}
+
+void CaptureWriter::close() {
+    if (!m_file) {
+        return;
+    }
+    std::FILE* file = m_file;
+    const uint64_t indexOffset = m_offset;
+    try {
+        for (uint64_t offset : m_offsets) {
+            char entry[8];
+            putLittleEndian(entry, offset, 8);
+            append(entry, sizeof(entry));
+        }
+        char trailer[kTrailerSize];
+        putLittleEndian(trailer, indexOffset, 8);
+        putLittleEndian(trailer + 8, m_offsets.size(), 8);
+        std::memcpy(trailer + 16, kIndexMagic, sizeof(kIndexMagic));
+        append(trailer, sizeof(trailer));
+    } catch (const std::exception&) {
+        m_file = nullptr;
+        std::fclose(file);
+        throw;
+    }
+    m_file = nullptr;
+    if (std::fclose(file) != 0) {
+        throw std::runtime_error("capture write failed");
+    }
+}
+
+CaptureRecorder::CaptureRecorder(const std::string& path, PacketListener* next)
+        : m_writer(path), m_next(next), m_startNs(monotonicNs()) {}
+
+void CaptureRecorder::ProcessPacket(const char* data, int size, const IpEndpointName& remoteEndpoint) {
+    m_writer.write(monotonicNs() - m_startNs, data, static_cast<size_t>(size), remoteEndpoint);
+    if (m_next) {
+        m_next->ProcessPacket(data, size, remoteEndpoint);
+    }
+}
+
+CaptureReader::CaptureReader(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("cannot open capture " + path);
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < kHeaderSize) {
+        ::close(fd);
+        throw std::runtime_error("not a capture: " + path);
+    }
+    m_size = static_cast<size_t>(status.st_size);
+    void* mapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("cannot map capture " + path);
+    }
+    m_begin = static_cast<const char*>(mapping);
+
+    if (std::memcmp(m_begin, kFileMagic, sizeof(kFileMagic)) != 0 || getLittleEndian(m_begin + 8, 4) != kVersion) {
+        munmap(const_cast<char*>(m_begin), m_size);
+        throw std::runtime_error("not a capture: " + path);
+    }
+
+    // Use the index if the trailer is intact and consistent, otherwise walk the records.
+    const char* trailer = m_begin + m_size - kTrailerSize;
+    if (m_size >= kHeaderSize + kTrailerSize && std::memcmp(trailer + 16, kIndexMagic, sizeof(kIndexMagic)) == 0) {
+        const uint64_t indexOffset = getLittleEndian(trailer, 8);
+        const uint64_t count = getLittleEndian(trailer + 8, 8);
+        if (indexOffset >= kHeaderSize && indexOffset <= m_size - kTrailerSize &&
+                count == (m_size - kTrailerSize - indexOffset) / 8) {
+            m_offsets.reserve(count);
+            for (uint64_t i = 0; i < count; ++i) {
+                const uint64_t offset = getLittleEndian(m_begin + indexOffset + 8 * i, 8);
+                if (offset < kHeaderSize || offset + kRecordHeaderSize > indexOffset ||
+                        offset + kRecordHeaderSize + getLittleEndian(m_begin + offset + 8, 4) > indexOffset) {
+                    munmap(const_cast<char*>(m_begin), m_size);
+                    throw std::runtime_error("corrupt capture index: " + path);
+                }
+                m_offsets.push_back(offset);
+                m_totalBytes += getLittleEndian(m_begin + offset + 8, 4);
+            }
+            return;
+        }
+    }
+    scanRecords(m_size);
+}
+
+CaptureReader::~CaptureReader() {
+    munmap(const_cast<char*>(m_begin), m_size);
+}
+
+void CaptureReader::scanRecords(uint64_t end) {
+    uint64_t offset = kHeaderSize;
+    while (offset + kRecordHeaderSize <= end) {
+        const uint64_t size = getLittleEndian(m_begin + offset + 8, 4);
+        const uint64_t next = offset + kRecordHeaderSize + padded(size);
+        if (next > end) {
+            break;
+        }
+        m_offsets.push_back(offset);
+        m_totalBytes += size;
+        offset = next;
+    }
+}
+
+CapturedPacket CaptureReader::packet(size_t index) const {
+    const char* record = m_begin + m_offsets[index];
+    CapturedPacket packet;
+    packet.timeNs = static_cast<int64_t>(getLittleEndian(record, 8));
+    packet.size = getLittleEndian(record + 8, 4);
+    packet.remoteEndpoint = IpEndpointName(static_cast<unsigned long>(getLittleEndian(record + 12, 4)),
+            static_cast<int>(getLittleEndian(record + 16, 2)));
+    packet.data = record + kRecordHeaderSize;
+    return packet;
+}
+
+} // namespace taposc
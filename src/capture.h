@@ -0,0 +1,100 @@
+#ifndef SRC_CAPTURE_H_
+#define SRC_CAPTURE_H_
+
+#include "ip/IpEndpointName.h"
+#include "ip/PacketListener.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// A capture file of timestamped OSC datagrams, for replaying recorded traffic through the decoders. All fields are
+// little-endian and every record starts on a 4 byte boundary, so packets can be decoded in place from a mapping:
+//
+//   header   "TAPOSCAP" version:u32 reserved:u32
+//   record   timeNs:u64 size:u32 address:u32 port:u16 reserved:u16, then |size| packet bytes zero-padded to 4
+//   ...
+//   index    offset:u64 of each record, in order
+//   trailer  indexOffset:u64 packetCount:u64 "TAPOSCIX"
+//
+// timeNs is the receive time relative to the start of the capture, address and port the sender's, in host order. The
+// index and trailer are written when the capture is closed; a file without them, say from a recorder that was killed,
+// is still readable by walking the records.
+namespace taposc {
+
+// Appends records to a new capture file. Throws std::runtime_error if the file cannot be created or written.
+class CaptureWriter {
+public:
+    explicit CaptureWriter(const std::string& path);
+    // Calls close(), ignoring errors.
+    ~CaptureWriter();
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    void write(int64_t timeNs, const char* data, size_t size, const IpEndpointName& remoteEndpoint);
+    // Writes the index and trailer and closes the file.
+    void close();
+
+    size_t packetCount() const { return m_offsets.size(); }
+
+private:
+    void append(const void* data, size_t size);
+
+    std::FILE* m_file;
+    uint64_t m_offset = 0;
+    std::vector<uint64_t> m_offsets;
+};
+
+// Records every packet it receives into a capture, timestamped from construction, then passes it on to |next| if one
+// is given, so it can sit in front of an application's own listener. Call it from one thread only, as
+// SocketReceiveMultiplexer does.
+class CaptureRecorder : public PacketListener {
+public:
+    explicit CaptureRecorder(const std::string& path, PacketListener* next = nullptr);
+
+    void ProcessPacket(const char* data, int size, const IpEndpointName& remoteEndpoint) override;
+
+    CaptureWriter& writer() { return m_writer; }
+
+private:
+    CaptureWriter m_writer;
+    PacketListener* m_next;
+    int64_t m_startNs;
+};
+
+struct CapturedPacket {
+    const char* data;
+    size_t size;
+    int64_t timeNs;
+    IpEndpointName remoteEndpoint;
+};
+
+// A capture file mapped read-only. Packets point into the mapping and stay valid for the lifetime of the object.
+// Throws std::runtime_error if the file cannot be opened or is not a capture.
+class CaptureReader {
+public:
+    explicit CaptureReader(const std::string& path);
+    ~CaptureReader();
+    CaptureReader(const CaptureReader&) = delete;
+    CaptureReader& operator=(const CaptureReader&) = delete;
+
+    size_t packetCount() const { return m_offsets.size(); }
+    CapturedPacket packet(size_t index) const;
+    // Sum of the packet sizes.
+    uint64_t totalBytes() const { return m_totalBytes; }
+
+private:
+    // Walks the records from the header when the index is missing, stopping at the first incomplete record.
+    void scanRecords(uint64_t end);
+
+    const char* m_begin = nullptr;
+    size_t m_size = 0;
+    std::vector<uint64_t> m_offsets;
+    uint64_t m_totalBytes = 0;
+};
+
+} // namespace taposc
+
+#endif // SRC_CAPTURE_H_
@@ -0,0 +1,120 @@
+#include "corpus.h"
+
+namespace {
+
+using taposc::Payload;
+
+// A fader move: the minimal OSC 1.0 types.
+Payload makeFader() {
+    Payload payload("/mixer/channel/3/fader");
+    payload.addInt32(3);
+    payload.addFloat(0.75f);
+    payload.addString(5);
+    return payload;
+}
+
+// A device status report with a small opaque blob.
+Payload makeDeviceState() {
+    Payload payload("/device/17/state");
+    payload.addInt32(17);
+    payload.addFloat(21.5f);
+    payload.addString(11);
+    payload.addBlob(30);
+    return payload;
+}
+
+// A cue trigger using every OSC 1.1 type once.
+Payload makeCue() {
+    Payload payload("/cue/42/go");
+    payload.addInt32(42);
+    payload.addFloat(1.5f);
+    payload.addString(7);
+    payload.addBlob(13);
+    payload.addInt64(1ll << 40);
+    payload.addDouble(3.0);
+    payload.addTimeTag(0xDA5F6E7A00000000ull);
+    payload.addBool(true);
+    payload.addBool(false);
+    payload.addNil();
+    payload.addInfinitum();
+    return payload;
+}
+
+// An inertial sensor frame with a microsecond timestamp: wide types interleaved with floats.
+Payload makeSensorFrame() {
+    Payload payload("/sensor/imu/frame");
+    payload.addInt64(1792265577123456ll);
+    payload.addInt32(9);
+    for (int i = 0; i < 9; ++i) {
+        payload.addFloat(static_cast<float>(i) * 0.125f);
+    }
+    payload.addDouble(47.6062);
+    payload.addDouble(-122.3321);
+    payload.addBool(true);
+    return payload;
+}
+
+// A lighting update grouping fixtures into nested arrays.
+Payload makeFixtureArrays() {
+    Payload payload("/light/group/2/rgb");
+    payload.addString(6);
+    payload.beginArray();
+    for (int fixture = 0; fixture < 4; ++fixture) {
+        payload.addInt32(fixture);
+        payload.beginArray();
+        payload.addFloat(1.0f);
+        payload.addFloat(0.5f);
+        payload.addFloat(0.25f);
+        payload.endArray();
+    }
+    payload.endArray();
+    payload.addBlob(7);
+    return payload;
+}
+
+// A 1-2 KiB mixed message, the size most of the production control traffic falls into.
+Payload makeBulkMixed() {
+    Payload payload("/gateway/batch");
+    for (int i = 0; i < 24; ++i) {
+        payload.addInt32(i);
+        payload.addFloat(static_cast<float>(i));
+        payload.addString(i % 13);
+        payload.addBlob(i % 29);
+        payload.addInt64(i);
+        payload.addDouble(i);
+        payload.addBool(i & 1);
+    }
+    return payload;
+}
+
+struct CorpusEntry {
+    const char* name;
+    Payload (*make)();
+};
+
+const CorpusEntry corpus[] = {
+    { "fader", makeFader },
+    { "device_state", makeDeviceState },
+    { "cue", makeCue },
+    { "sensor_frame", makeSensorFrame },
+    { "fixture_arrays", makeFixtureArrays },
+    { "bulk_mixed", makeBulkMixed },
+};
+
+} // namespace
+
+namespace taposc {
+
+size_t corpusSize() {
+    return sizeof(corpus) / sizeof(corpus[0]);
+}
+
+const char* corpusName(size_t index) {
+    return corpus[index].name;
+}
+
+Payload makeCorpusMessage(size_t index) {
+    return corpus[index].make();
+}
+
+} // namespace taposc
@@ -0,0 +1,18 @@
+#ifndef SRC_CORPUS_H_
+#define SRC_CORPUS_H_
+
+#include "payload.h"
+
+#include <cstddef>
+
+// A small corpus of heterogeneous messages modeled on show-control and sensor traffic. Unlike the homogeneous payload
+// shapes these exercise type tag dispatch and the alignment padding between differently sized arguments.
+namespace taposc {
+
+size_t corpusSize();
+const char* corpusName(size_t index);
+Payload makeCorpusMessage(size_t index);
+
+} // namespace taposc
+
+#endif // SRC_CORPUS_H_
@@ -0,0 +1,102 @@
+#include "addresses.h"
+#include "bench.h"
+
+#include "ip/IpEndpointName.h"
+#include "osc/HashedMessageMappingOscPacketListener.h"
+#include "osc/MessageMappingOscPacketListener.h"
+#include "osc/OscOutboundPacketStream.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Dispatching received packets to per-address handlers: oscpack's MessageMappingOscPacketListener, a std::map keyed
+// on strcmp, against osc::HashedMessageMappingOscPacketListener. Each iteration decodes one packet and calls its
+// handler. The pattern variant sends address patterns, which the hashed listener resolves by scanning every
+// registered address.
+
+namespace {
+
+const size_t kTrafficSize = 1024;
+
+void addressSweep(benchmark::internal::Benchmark* b) {
+    b->ArgName("addresses")->Arg(10)->Arg(1000)->Arg(100000);
+}
+
+template <template <class> class Mapping>
+class CountingListener : public Mapping<CountingListener<Mapping>> {
+public:
+    explicit CountingListener(const std::vector<std::string>& addresses) {
+        for (const std::string& address : addresses) {
+            this->RegisterMessageFunction(address.c_str(), &CountingListener::count);
+        }
+    }
+
+    void count(const osc::ReceivedMessage&, const IpEndpointName&) { ++dispatched; }
+
+    uint64_t dispatched = 0;
+};
+
+// Packets of one int32 argument addressed to each of |addresses| in turn.
+std::vector<std::vector<char>> makePackets(const std::vector<std::string>& addresses) {
+    std::vector<std::vector<char>> packets;
+    for (const std::string& address : addresses) {
+        std::vector<char> buffer(address.size() + 64);
+        osc::OutboundPacketStream p(buffer.data(), buffer.size());
+        p << osc::BeginMessage(address.c_str()) << static_cast<osc::int32>(1) << osc::EndMessage;
+        buffer.resize(p.Size());
+        packets.push_back(std::move(buffer));
+    }
+    return packets;
+}
+
+template <typename Listener>
+void dispatch(benchmark::State& state, const std::vector<std::string>& addresses,
+        const std::vector<std::string>& traffic) {
+    Listener listener(addresses);
+    const std::vector<std::vector<char>> packets = makePackets(traffic);
+    const IpEndpointName endpoint;
+
+    size_t next = 0;
+    HeapMeter heap;
+    for (auto _ : state) {
+        const std::vector<char>& packet = packets[next++ % kTrafficSize];
+        listener.ProcessPacket(packet.data(), static_cast<int>(packet.size()), endpoint);
+    }
+    heap.report(state);
+    state.SetItemsProcessed(state.iterations());
+    state.counters["handlers/message"] =
+            benchmark::Counter(static_cast<double>(listener.dispatched), benchmark::Counter::kAvgIterations);
+}
+
+std::vector<std::string> makeSpace(size_t count) {
+    std::vector<std::string> addresses;
+    addresses.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        addresses.push_back(taposc::makeAddress(i));
+    }
+    return addresses;
+}
+
+} // namespace
+
+template <template <class> class Mapping>
+static void BM_dispatch(benchmark::State& state) {
+    const std::vector<std::string> addresses = makeSpace(state.range(0));
+    dispatch<CountingListener<Mapping>>(state, addresses, taposc::makeTraffic(addresses.size(), kTrafficSize, 3));
+}
+
+static void BM_dispatch_pattern(benchmark::State& state) {
+    const std::vector<std::string> addresses = makeSpace(state.range(0));
+    const std::vector<std::string> patterns = taposc::makeHandlerPatterns(addresses.size(), 100, 4);
+    std::vector<std::string> traffic;
+    for (size_t i = 0; i < kTrafficSize; ++i) {
+        traffic.push_back(patterns[i * 7919 % patterns.size()]);
+    }
+    dispatch<CountingListener<osc::HashedMessageMappingOscPacketListener>>(state, addresses, traffic);
+}
+
+BENCHMARK_TEMPLATE(BM_dispatch, osc::MessageMappingOscPacketListener)->Apply(addressSweep);
+BENCHMARK_TEMPLATE(BM_dispatch, osc::HashedMessageMappingOscPacketListener)->Apply(addressSweep);
+BENCHMARK(BM_dispatch_pattern)->Apply(addressSweep);
@@ -0,0 +1,246 @@
+#ifndef SRC_HANDOFF_H_
+#define SRC_HANDOFF_H_
+
+#include "ip/PacketListener.h"
+#include "ip/UdpSocket.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Bounded rings for handing received packets from a SocketReceiveMultiplexer thread to a consumer that must not block,
+// such as an audio callback. Neither ring allocates after construction or takes a lock. Capacities are rounded up to a
+// power of two.
+namespace taposc {
+
+constexpr size_t kCacheLineSize = 64;
+
+inline size_t ringCapacity(size_t capacity) {
+    size_t rounded = 1;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    return rounded;
+}
+
+// One producer thread and one consumer thread. tryPush() and tryPop() are wait-free. The two indices sit on separate
+// cache lines, and each side keeps a private copy of the other side's index that it only refreshes when the ring
+// looks full or empty, so in steady state neither side reads the line the other writes.
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity)
+            : m_mask(ringCapacity(capacity) - 1), m_slots(new T[m_mask + 1]) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    size_t capacity() const { return m_mask + 1; }
+
+    bool tryPush(const T& value) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead > m_mask) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead > m_mask) {
+                return false;
+            }
+        }
+        m_slots[tail & m_mask] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& value) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cachedTail) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail) {
+                return false;
+            }
+        }
+        value = m_slots[head & m_mask];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    const size_t m_mask;
+    const std::unique_ptr<T[]> m_slots;
+
+    // Written by the consumer.
+    alignas(kCacheLineSize) std::atomic<size_t> m_head{0};
+    size_t m_cachedTail = 0;
+
+    // Written by the producer.
+    alignas(kCacheLineSize) std::atomic<size_t> m_tail{0};
+    size_t m_cachedHead = 0;
+};
+
+// Any number of producer threads and one consumer thread, after Vyukov's bounded queue: every slot carries a sequence
+// number saying whether it is free for the push of a given lap or holds a value for the pop of that lap. tryPop() is
+// wait-free. tryPush() claims a slot with a compare-and-swap on the shared tail, so it is lock-free: a producer retries
+// when another one claimed the slot first, but never waits for another producer to finish. A pop that reaches a slot
+// whose producer has claimed it but not yet published the value reports the ring as empty. Slots are padded to a cache
+// line so that producers filling neighbouring slots don't contend.
+template <typename T>
+class MpscRing {
+public:
+    explicit MpscRing(size_t capacity)
+            : m_mask(ringCapacity(capacity) - 1), m_slots(new Slot[m_mask + 1]) {
+        for (size_t i = 0; i <= m_mask; ++i) {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    size_t capacity() const { return m_mask + 1; }
+
+    bool tryPush(const T& value) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = m_slots[tail & m_mask];
+            const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            const intptr_t lap = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(tail);
+            if (lap == 0) {
+                if (m_tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+                    slot.value = value;
+                    slot.sequence.store(tail + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lap < 0) {
+                return false; // the consumer has not emptied this slot since the previous lap
+            } else {
+                tail = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& value) {
+        Slot& slot = m_slots[m_head & m_mask];
+        if (slot.sequence.load(std::memory_order_acquire) != m_head + 1) {
+            return false;
+        }
+        value = slot.value;
+        slot.sequence.store(m_head + m_mask + 1, std::memory_order_release);
+        ++m_head;
+        return true;
+    }
+
+private:
+    struct alignas(kCacheLineSize) Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    const size_t m_mask;
+    const std::unique_ptr<Slot[]> m_slots;
+
+    // Only the consumer reads or writes the head.
+    alignas(kCacheLineSize) size_t m_head = 0;
+    alignas(kCacheLineSize) std::atomic<size_t> m_tail{0};
+};
+
+class HandoffListenerBase;
+
+// A packet handed to the consumer. |data| is a receive buffer retained from the multiplexer, which stays valid until
+// the consumer passes the packet to releasePacket().
+struct HandedOffPacket {
+    const char* data;
+    int size;
+    IpEndpointName remoteEndpoint;
+    HandoffListenerBase* owner;
+};
+
+// Consumer side of every HandoffListener: returns the buffer of |packet| to the listener that handed it off. Wait-free.
+void releasePacket(const HandedOffPacket& packet);
+
+class HandoffListenerBase : public PacketListener {
+public:
+    // Packets that could not be handed off because the ring was full or too many buffers were out.
+    int64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+protected:
+    HandoffListenerBase(SocketReceiveMultiplexer& multiplexer, size_t maxOutstanding)
+            : m_multiplexer(multiplexer), m_returned(maxOutstanding), m_maxOutstanding(m_returned.capacity()) {}
+
+    ~HandoffListenerBase() override { reclaim(); }
+
+    // Gives buffers the consumer has finished with back to the multiplexer. Receive thread only.
+    void reclaim() {
+        char* data;
+        while (m_returned.tryPop(data)) {
+            m_multiplexer.ReleasePacketBuffer(data);
+            --m_outstanding;
+        }
+    }
+
+    // Retains the packet being processed for handing off, or returns false if too many buffers are out already.
+    bool retain(HandedOffPacket& packet, int size, const IpEndpointName& remoteEndpoint) {
+        reclaim();
+        if (m_outstanding == m_maxOutstanding) {
+            return false;
+        }
+        packet.data = m_multiplexer.RetainPacketBuffer();
+        packet.size = size;
+        packet.remoteEndpoint = remoteEndpoint;
+        packet.owner = this;
+        ++m_outstanding;
+        return true;
+    }
+
+    // Undoes retain() for a packet that the ring would not take.
+    void drop(const HandedOffPacket& packet) {
+        m_multiplexer.ReleasePacketBuffer(const_cast<char*>(packet.data));
+        --m_outstanding;
+    }
+
+    std::atomic<int64_t> m_dropped{0};
+
+private:
+    friend void releasePacket(const HandedOffPacket& packet);
+
+    SocketReceiveMultiplexer& m_multiplexer;
+    // Buffers on their way back from the consumer. It holds every buffer that can be out at once, so the consumer's
+    // push never fails.
+    SpscRing<char*> m_returned;
+    const size_t m_maxOutstanding;
+    size_t m_outstanding = 0;
+};
+
+inline void releasePacket(const HandedOffPacket& packet) {
+    packet.owner->m_returned.tryPush(const_cast<char*>(packet.data));
+}
+
+// Hands every packet its multiplexer receives to |Ring| without copying it: ProcessPacket() retains the receive buffer
+// and pushes a HandedOffPacket. When the ring is full the packet is dropped and counted rather than blocking the
+// receive thread. The consumer must releasePacket() every packet it pops before the listener is destroyed, and the
+// listener must be destroyed before its multiplexer. At most |maxOutstanding| packets can be queued or held at once.
+// Use SpscRing for one listener and MpscRing to merge several multiplexer threads into one consumer.
+template <typename Ring>
+class HandoffListener : public HandoffListenerBase {
+public:
+    HandoffListener(SocketReceiveMultiplexer& multiplexer, Ring& ring, size_t maxOutstanding)
+            : HandoffListenerBase(multiplexer, maxOutstanding), m_ring(ring) {}
+
+    void ProcessPacket(const char*, int size, const IpEndpointName& remoteEndpoint) override {
+        HandedOffPacket packet;
+        if (!retain(packet, size, remoteEndpoint)) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (!m_ring.tryPush(packet)) {
+            drop(packet);
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    Ring& m_ring;
+};
+
+} // namespace taposc
+
+#endif // SRC_HANDOFF_H_
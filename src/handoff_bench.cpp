@@ -0,0 +1,207 @@
+#include "bench.h"
+#include "handoff.h"
+#include "transports.h"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using taposc::HandedOffPacket;
+using taposc::HandoffListener;
+using taposc::MpscRing;
+using taposc::SpscRing;
+
+// Handing packets from receive threads to one consumer thread. MutexRing is the queue a consumer would otherwise build
+// itself: the same bounded ring behind a std::mutex.
+//
+// BM_handoff_ring measures the rings alone. Producer threads push packet descriptors as fast as the ring takes them
+// while the benchmark thread pops, so items/s is the consumer's rate under contention from all producers at once.
+//
+// BM_handoff_latency goes through the network: one probe at a time is sent to one of |producers| sockets, each
+// received by its own SocketReceiveMultiplexer thread and handed off through a HandoffListener without copying. The
+// benchmark thread polls the ring like an audio callback would and records the time from send() to pop.
+
+namespace {
+
+const int64_t kPopsPerIteration = 1024;
+const size_t kRingCapacity = 1024;
+
+template <typename T>
+class MutexRing {
+public:
+    explicit MutexRing(size_t capacity) : m_slots(taposc::ringCapacity(capacity)) {}
+
+    bool tryPush(const T& value) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_tail - m_head == m_slots.size()) {
+            return false;
+        }
+        m_slots[m_tail++ & (m_slots.size() - 1)] = value;
+        return true;
+    }
+
+    bool tryPop(T& value) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_head == m_tail) {
+            return false;
+        }
+        value = m_slots[m_head++ & (m_slots.size() - 1)];
+        return true;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::vector<T> m_slots;
+    size_t m_head = 0;
+    size_t m_tail = 0;
+};
+
+void producerSweep(benchmark::internal::Benchmark* b) {
+    b->ArgName("producers")->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+}
+
+void singleProducer(benchmark::internal::Benchmark* b) {
+    b->ArgName("producers")->Arg(1)->UseRealTime();
+}
+
+} // namespace
+
+template <typename Ring>
+static void BM_handoff_ring(benchmark::State& state) {
+    const int producerCount = static_cast<int>(state.range(0));
+    Ring ring(kRingCapacity);
+
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> producers;
+    for (int i = 0; i < producerCount; ++i) {
+        producers.emplace_back([&, i] {
+            HandedOffPacket packet{};
+            packet.size = i;
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (!ring.tryPush(packet)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    HandedOffPacket packet;
+    int64_t checksum = 0;
+    for (auto _ : state) {
+        for (int64_t popped = 0; popped < kPopsPerIteration;) {
+            if (ring.tryPop(packet)) {
+                checksum += packet.size;
+                ++popped;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+    benchmark::DoNotOptimize(checksum);
+
+    stop.store(true);
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    state.SetItemsProcessed(state.iterations() * kPopsPerIteration);
+}
+
+BENCHMARK_TEMPLATE(BM_handoff_ring, SpscRing<HandedOffPacket>)->Apply(singleProducer);
+BENCHMARK_TEMPLATE(BM_handoff_ring, MpscRing<HandedOffPacket>)->Apply(producerSweep);
+BENCHMARK_TEMPLATE(BM_handoff_ring, MutexRing<HandedOffPacket>)->Apply(producerSweep);
+
+template <typename Ring>
+static void BM_handoff_latency(benchmark::State& state) {
+    const int producerCount = static_cast<int>(state.range(0));
+    Ring ring(kRingCapacity);
+
+    // A receiving socket, its multiplexer thread and listener per producer. Listeners are destroyed before their
+    // multiplexers, and both after the threads have stopped.
+    struct Producer {
+        UdpSocket socket;
+        SocketReceiveMultiplexer multiplexer;
+        std::unique_ptr<HandoffListener<Ring>> listener;
+        std::unique_ptr<UdpTransmitSocket> sender;
+        std::thread thread;
+        std::atomic<bool> finished{false};
+        std::string error;
+    };
+    std::vector<std::unique_ptr<Producer>> producers;
+    try {
+        for (int i = 0; i < producerCount; ++i) {
+            producers.emplace_back(new Producer);
+            Producer& producer = *producers.back();
+            const int port = taposc::bindLoopback(producer.socket);
+            producer.listener.reset(new HandoffListener<Ring>(producer.multiplexer, ring, kRingCapacity));
+            producer.multiplexer.AttachSocketListener(&producer.socket, producer.listener.get());
+            producer.sender.reset(new UdpTransmitSocket(IpEndpointName("127.0.0.1", port)));
+        }
+    } catch (const std::exception& e) {
+        state.SkipWithError(e.what());
+        return;
+    }
+    for (std::unique_ptr<Producer>& producer : producers) {
+        Producer* p = producer.get();
+        p->thread = std::thread([p] {
+            try {
+                p->multiplexer.Run();
+            } catch (const std::exception& e) {
+                p->error = e.what();
+            }
+            p->finished.store(true);
+        });
+    }
+
+    taposc::LatencyHistogram latencies;
+    int64_t sent = 0;
+    HandedOffPacket packet{};
+    for (auto _ : state) {
+        const int64_t sentNs = taposc::monotonicNs();
+        producers[sent % producerCount]->sender->Send(reinterpret_cast<const char*>(&sentNs), sizeof(sentNs));
+        ++sent;
+
+        const int64_t deadlineNs = sentNs + 1000000000;
+        while (!ring.tryPop(packet)) {
+            if (taposc::monotonicNs() > deadlineNs) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+        if (packet.size != sizeof(sentNs)) {
+            state.SkipWithError("packet lost!");
+            break;
+        }
+        latencies.record(taposc::monotonicNs() - sentNs);
+        taposc::releasePacket(packet);
+        packet.size = 0;
+    }
+
+    // Run() clears the break flag on entry, so a producer that had not got there yet, say one that no probe was sent
+    // to, would miss a single break. Keep breaking until each thread has left Run().
+    for (std::unique_ptr<Producer>& producer : producers) {
+        while (!producer->finished.load()) {
+            producer->multiplexer.AsynchronousBreak();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        producer->thread.join();
+        if (!producer->error.empty()) {
+            state.SkipWithError(producer->error.c_str());
+        }
+    }
+    // Hand back anything that arrived after the loop stopped waiting.
+    while (ring.tryPop(packet)) {
+        taposc::releasePacket(packet);
+    }
+
+    state.SetItemsProcessed(sent);
+    setLatency(state, latencies);
+}
+
+BENCHMARK_TEMPLATE(BM_handoff_latency, SpscRing<HandedOffPacket>)->Apply(singleProducer);
+BENCHMARK_TEMPLATE(BM_handoff_latency, MpscRing<HandedOffPacket>)->Apply(producerSweep);
+BENCHMARK_TEMPLATE(BM_handoff_latency, MutexRing<HandedOffPacket>)->Apply(producerSweep);
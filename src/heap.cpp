@@ -0,0 +1,167 @@
+#include "heap.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace {
+
+// Plain TLS so that reading it from inside malloc never allocates.
+__thread taposc::Arena* activeArena = nullptr;
+__thread taposc::HeapStats threadStats = {};
+
+const size_t kAlignment = 16;
+
+} // namespace
+
+namespace taposc {
+
+Arena::Arena(size_t capacity) {
+    m_begin = static_cast<char*>(std::malloc(capacity));
+    m_end = m_begin ? m_begin + capacity : m_begin;
+    m_current = m_begin;
+}
+
+Arena::~Arena() {
+    std::free(m_begin);
+}
+
+// Each allocation is preceded by a kAlignment sized header holding the requested size, which realloc needs.
+void* Arena::allocate(size_t size) {
+    const size_t rounded = (size + kAlignment - 1) & ~(kAlignment - 1);
+    if (static_cast<size_t>(m_end - m_current) < kAlignment + rounded) {
+        return nullptr;
+    }
+    char* header = m_current;
+    m_current += kAlignment + rounded;
+    *reinterpret_cast<size_t*>(header) = size;
+    return header + kAlignment;
+}
+
+size_t Arena::allocationSize(const void* p) const {
+    return *reinterpret_cast<const size_t*>(static_cast<const char*>(p) - kAlignment);
+}
+
+ArenaScope::ArenaScope(Arena& arena) : m_previous(activeArena) {
+    activeArena = &arena;
+}
+
+ArenaScope::~ArenaScope() {
+    activeArena = m_previous;
+}
+
+#if defined(__GLIBC__)
+
+bool heapHooksInstalled() {
+    return true;
+}
+
+HeapStats heapStats() {
+    return threadStats;
+}
+
+void resetHeapPeak() {
+    threadStats.peakLiveBytes = threadStats.liveBytes;
+}
+
+#else
+
+bool heapHooksInstalled() {
+    return false;
+}
+
+HeapStats heapStats() {
+    return threadStats;
+}
+
+void resetHeapPeak() {}
+
+#endif
+
+} // namespace taposc
+
+#if defined(__GLIBC__)
+
+extern "C" {
+
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* p, size_t size);
+void __libc_free(void* p);
+
+static void* countAllocation(void* p, size_t size) {
+    if (p) {
+        ++threadStats.allocations;
+        threadStats.bytes += size;
+        threadStats.liveBytes += malloc_usable_size(p);
+        if (threadStats.liveBytes > threadStats.peakLiveBytes) {
+            threadStats.peakLiveBytes = threadStats.liveBytes;
+        }
+    }
+    return p;
+}
+
+static void countFree(void* p) {
+    if (p) {
+        threadStats.liveBytes -= malloc_usable_size(p);
+    }
+}
+
+void* malloc(size_t size) noexcept {
+    if (activeArena) {
+        if (void* p = activeArena->allocate(size)) {
+            return p;
+        }
+    }
+    return countAllocation(__libc_malloc(size), size);
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+    if (activeArena && (size == 0 || count <= SIZE_MAX / size)) {
+        if (void* p = activeArena->allocate(count * size)) {
+            std::memset(p, 0, count * size);
+            return p;
+        }
+    }
+    return countAllocation(__libc_calloc(count, size), count * size);
+}
+
+void* realloc(void* p, size_t size) noexcept {
+    if (activeArena && activeArena->owns(p)) {
+        const size_t oldSize = activeArena->allocationSize(p);
+        if (size <= oldSize) {
+            return p;
+        }
+        void* q = malloc(size);
+        if (q) {
+            std::memcpy(q, p, oldSize);
+        }
+        return q;
+    }
+    if (activeArena && !p) {
+        return malloc(size);
+    }
+    // A failed realloc leaves |p| allocated, so only release it from the live count once a new block exists.
+    const size_t oldUsable = p ? malloc_usable_size(p) : 0;
+    void* q = __libc_realloc(p, size);
+    if (q || size == 0) {
+        threadStats.liveBytes -= oldUsable;
+    }
+    return countAllocation(q, size);
+}
+
+void free(void* p) noexcept {
+    if (activeArena && activeArena->owns(p)) {
+        return;
+    }
+    countFree(p);
+    __libc_free(p);
+}
+
+} // extern "C"
+
+#endif // __GLIBC__
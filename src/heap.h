@@ -0,0 +1,71 @@
+#ifndef SRC_HEAP_H_
+#define SRC_HEAP_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// Heap interposition for cppbench. On glibc the executable replaces malloc, calloc, realloc and free, forwarding to
+// the C library unless the calling thread has installed an Arena. Everything in the process allocates through these,
+// including statically linked liblo and operator new.
+namespace taposc {
+
+// True when the malloc replacements are compiled in. Elsewhere Arena still works as a plain allocator but
+// ArenaScope has no effect on malloc and heapStats() stays zero.
+bool heapHooksInstalled();
+
+// Heap traffic of one thread. Only requests that reach the C library are counted, so memory served by an Arena is
+// free. Live bytes are the usable sizes of blocks still allocated, and go negative when a thread frees memory that
+// another thread allocated.
+struct HeapStats {
+    uint64_t allocations;
+    uint64_t bytes;
+    int64_t liveBytes;
+    int64_t peakLiveBytes;
+};
+
+// Counters of the calling thread since it started.
+HeapStats heapStats();
+// Restarts peak tracking of the calling thread from its current live bytes.
+void resetHeapPeak();
+
+// A bump allocator with bulk reset. While installed on a thread through ArenaScope it serves every malloc, calloc and
+// realloc made by that thread, and free() of its memory is a no-op. Requests that do not fit fall back to the C
+// library.
+class Arena {
+public:
+    explicit Arena(size_t capacity);
+    ~Arena();
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Returns 16-byte aligned memory, or nullptr if the arena is exhausted.
+    void* allocate(size_t size);
+    // Size requested for |p|, which must have come from allocate().
+    size_t allocationSize(const void* p) const;
+    bool owns(const void* p) const { return p >= m_begin && p < m_end; }
+    // Releases every allocation at once.
+    void reset() { m_current = m_begin; }
+    size_t used() const { return m_current - m_begin; }
+
+private:
+    char* m_begin;
+    char* m_end;
+    char* m_current;
+};
+
+// Installs |arena| for the current thread for the lifetime of the scope. Scopes nest. Memory taken from the arena
+// must be freed, or abandoned, before the scope ends: once uninstalled the arena no longer recognizes its pointers.
+class ArenaScope {
+public:
+    explicit ArenaScope(Arena& arena);
+    ~ArenaScope();
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    Arena* m_previous;
+};
+
+} // namespace taposc
+
+#endif // SRC_HEAP_H_
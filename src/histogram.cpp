@@ -0,0 +1,48 @@
+#include "histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// The bucket of the largest uint64_t value, see LatencyHistogram::bucketOf().
+const size_t kBucketCount = 57 * 64 + 128;
+
+// Largest value that falls in |bucket|.
+uint64_t bucketTop(size_t bucket) {
+    if (bucket < 128) {
+        return bucket;
+    }
+    const int shift = static_cast<int>(bucket / 64) - 1;
+    const uint64_t mantissa = bucket - static_cast<uint64_t>(shift) * 64;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+} // namespace
+
+namespace taposc {
+
+LatencyHistogram::LatencyHistogram() : m_counts(kBucketCount), m_count(0), m_max(0) {}
+
+void LatencyHistogram::reset() {
+    std::fill(m_counts.begin(), m_counts.end(), 0);
+    m_count = 0;
+    m_max = 0;
+}
+
+uint64_t LatencyHistogram::percentile(double percentile) const {
+    if (m_count == 0) {
+        return 0;
+    }
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * m_count)));
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < m_counts.size(); ++bucket) {
+        seen += m_counts[bucket];
+        if (seen >= rank) {
+            return std::min(bucketTop(bucket), m_max);
+        }
+    }
+    return m_max;
+}
+
+} // namespace taposc
@@ -0,0 +1,55 @@
+#ifndef SRC_HISTOGRAM_H_
+#define SRC_HISTOGRAM_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace taposc {
+
+inline int64_t monotonicNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// A fixed-precision log-linear histogram in the style of HdrHistogram. Values below 128 are recorded exactly, larger
+// ones in buckets whose width is 1/64 of their magnitude, so every reported value is within 1.6% of a recorded one.
+// record() is a handful of instructions and never allocates, so it can sit inside a timed loop.
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    void record(uint64_t value) {
+        ++m_counts[bucketOf(value)];
+        ++m_count;
+        if (value > m_max) {
+            m_max = value;
+        }
+    }
+
+    void reset();
+
+    uint64_t count() const { return m_count; }
+    uint64_t max() const { return m_max; }
+    // The smallest value that at least |percentile| percent of the recorded values do not exceed, rounded up to the
+    // top of its bucket and clamped to max(). Returns 0 when empty.
+    uint64_t percentile(double percentile) const;
+
+private:
+    static size_t bucketOf(uint64_t value) {
+        if (value < 128) {
+            return static_cast<size_t>(value);
+        }
+        const int shift = 63 - __builtin_clzll(value) - 6;
+        return static_cast<size_t>(shift) * 64 + static_cast<size_t>(value >> shift);
+    }
+
+    std::vector<uint64_t> m_counts;
+    uint64_t m_count;
+    uint64_t m_max;
+};
+
+} // namespace taposc
+
+#endif // SRC_HISTOGRAM_H_
@@ -0,0 +1,150 @@
+#include "bench.h"
+
+#include "adapters.h"
+
+#include <cstdint>
+#include <vector>
+
+using taposc::Liblo;
+using taposc::Oscpack;
+using taposc::Oscpkt;
+using taposc::Oscpp;
+
+// Latency mode: the serialize and deserialize cases again, but timing every operation individually into a
+// LatencyHistogram so that the counters show the tail (p99.9 and max) that the mean reported by Google Benchmark
+// hides. The cost of reading the clock is measured once and subtracted from every sample.
+
+namespace {
+
+int64_t clockOverheadNs() {
+    static const int64_t overhead = [] {
+        int64_t best = INT64_MAX;
+        for (int i = 0; i < 1000; ++i) {
+            const int64_t start = taposc::monotonicNs();
+            const int64_t elapsed = taposc::monotonicNs() - start;
+            if (elapsed < best) {
+                best = elapsed;
+            }
+        }
+        return best;
+    }();
+    return overhead;
+}
+
+uint64_t sampleSince(int64_t startNs, int64_t overheadNs) {
+    const int64_t elapsed = taposc::monotonicNs() - startNs - overheadNs;
+    return elapsed > 0 ? static_cast<uint64_t>(elapsed) : 0;
+}
+
+} // namespace
+
+template <typename Library, typename Shape>
+static void BM_serialize_latency(benchmark::State& state) {
+    const Payload payload = Shape::make(state);
+    if (!taposc::supports<Library>(payload)) {
+        state.SkipWithError("unsupported type tags!");
+        return;
+    }
+    std::vector<char> buffer(payload.packetSize());
+    taposc::LatencyHistogram histogram;
+    const int64_t overhead = clockOverheadNs();
+
+    size_t size = 0;
+    for (auto _ : state) {
+        const int64_t start = taposc::monotonicNs();
+        size = Library::serialize(payload, buffer.data(), buffer.size());
+        histogram.record(sampleSince(start, overhead));
+        if (size != buffer.size()) {
+            state.SkipWithError("size mismatch!");
+        }
+    }
+    setLatency(state, histogram);
+    setThroughput(state, size, 1);
+}
+
+template <typename Library, typename Shape>
+static void BM_deserialize_latency(benchmark::State& state) {
+    const Payload payload = Shape::make(state);
+    if (!taposc::supports<Library>(payload)) {
+        state.SkipWithError("unsupported type tags!");
+        return;
+    }
+    const std::vector<char> packet = Library::encode(payload);
+    taposc::LatencyHistogram histogram;
+    const int64_t overhead = clockOverheadNs();
+
+    for (auto _ : state) {
+        const int64_t start = taposc::monotonicNs();
+        const bool ok = Library::deserialize(packet.data(), packet.size());
+        histogram.record(sampleSince(start, overhead));
+        if (!ok) {
+            state.SkipWithError("not message!");
+        }
+    }
+    setLatency(state, histogram);
+    setThroughput(state, packet.size(), 1);
+}
+
+BENCHMARK_TEMPLATE(BM_serialize_latency, Liblo, Empty)->Apply(Empty::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Liblo, Int32Series)->Apply(Int32Series::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Liblo, FloatSeries)->Apply(FloatSeries::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Liblo, String)->Apply(String::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Liblo, Blob)->Apply(Blob::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Liblo, Mixed)->Apply(Mixed::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Liblo, Corpus)->Apply(Corpus::sweep);
+
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Liblo, Empty)->Apply(Empty::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Liblo, Int32Series)->Apply(Int32Series::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Liblo, FloatSeries)->Apply(FloatSeries::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Liblo, String)->Apply(String::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Liblo, Blob)->Apply(Blob::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Liblo, Mixed)->Apply(Mixed::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Liblo, Corpus)->Apply(Corpus::sweep);
+
+BENCHMARK_TEMPLATE(BM_serialize_latency, Oscpack, Empty)->Apply(Empty::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Oscpack, Int32Series)->Apply(Int32Series::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Oscpack, FloatSeries)->Apply(FloatSeries::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Oscpack, String)->Apply(String::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Oscpack, Blob)->Apply(Blob::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Oscpack, Mixed)->Apply(Mixed::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Oscpack, Corpus)->Apply(Corpus::sweep);
+
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Oscpack, Empty)->Apply(Empty::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Oscpack, Int32Series)->Apply(Int32Series::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Oscpack, FloatSeries)->Apply(FloatSeries::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Oscpack, String)->Apply(String::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Oscpack, Blob)->Apply(Blob::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Oscpack, Mixed)->Apply(Mixed::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Oscpack, Corpus)->Apply(Corpus::sweep);
+
+BENCHMARK_TEMPLATE(BM_serialize_latency, Oscpkt, Empty)->Apply(Empty::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Oscpkt, Int32Series)->Apply(Int32Series::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Oscpkt, FloatSeries)->Apply(FloatSeries::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Oscpkt, String)->Apply(String::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Oscpkt, Blob)->Apply(Blob::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Oscpkt, Mixed)->Apply(Mixed::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Oscpkt, Corpus)->Apply(Corpus::sweep);
+
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Oscpkt, Empty)->Apply(Empty::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Oscpkt, Int32Series)->Apply(Int32Series::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Oscpkt, FloatSeries)->Apply(FloatSeries::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Oscpkt, String)->Apply(String::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Oscpkt, Blob)->Apply(Blob::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Oscpkt, Mixed)->Apply(Mixed::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Oscpkt, Corpus)->Apply(Corpus::sweep);
+
+BENCHMARK_TEMPLATE(BM_serialize_latency, Oscpp, Empty)->Apply(Empty::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Oscpp, Int32Series)->Apply(Int32Series::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Oscpp, FloatSeries)->Apply(FloatSeries::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Oscpp, String)->Apply(String::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Oscpp, Blob)->Apply(Blob::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Oscpp, Mixed)->Apply(Mixed::sweep);
+BENCHMARK_TEMPLATE(BM_serialize_latency, Oscpp, Corpus)->Apply(Corpus::sweep);
+
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Oscpp, Empty)->Apply(Empty::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Oscpp, Int32Series)->Apply(Int32Series::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Oscpp, FloatSeries)->Apply(FloatSeries::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Oscpp, String)->Apply(String::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Oscpp, Blob)->Apply(Blob::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Oscpp, Mixed)->Apply(Mixed::sweep);
+BENCHMARK_TEMPLATE(BM_deserialize_latency, Oscpp, Corpus)->Apply(Corpus::sweep);
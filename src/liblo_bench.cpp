@@ -0,0 +1,109 @@
+#include "bench.h"
+
+#include "adapters.h"
+#include "heap.h"
+
+#include <vector>
+
+using taposc::Liblo;
+
+// liblo builds every message on the heap, so BM_serialize<Liblo, ...> is dominated by allocation. These split that
+// cost out: BM_liblo_build measures building and freeing a message, BM_liblo_serialize_prebuilt only encodes a
+// message built once during setup, and BM_liblo_serialize_pooled runs the full serialize path with the heap served
+// by an Arena that is reset every iteration.
+
+template <typename Shape>
+static void BM_liblo_build(benchmark::State& state) {
+    const Payload payload = Shape::make(state);
+    if (!taposc::supports<Liblo>(payload)) {
+        state.SkipWithError("unsupported type tags!");
+        return;
+    }
+
+    HeapMeter heap;
+    for (auto _ : state) {
+        lo_message message = Liblo::build(payload);
+        benchmark::DoNotOptimize(message);
+        lo_message_free(message);
+    }
+    heap.report(state);
+    setThroughput(state, payload.packetSize(), 1);
+}
+
+template <typename Shape>
+static void BM_liblo_serialize_prebuilt(benchmark::State& state) {
+    const Payload payload = Shape::make(state);
+    if (!taposc::supports<Liblo>(payload)) {
+        state.SkipWithError("unsupported type tags!");
+        return;
+    }
+    lo_message message = Liblo::build(payload);
+    std::vector<char> buffer(payload.packetSize());
+
+    size_t size = 0;
+    HeapMeter heap;
+    for (auto _ : state) {
+        lo_message_serialise(message, payload.address(), buffer.data(), &size);
+        if (size != buffer.size()) {
+            state.SkipWithError("size mismatch!");
+        }
+    }
+    lo_message_free(message);
+    heap.report(state);
+    setThroughput(state, size, 1);
+}
+
+template <typename Shape>
+static void BM_liblo_serialize_pooled(benchmark::State& state) {
+    if (!taposc::heapHooksInstalled()) {
+        state.SkipWithError("malloc interposition unavailable!");
+        return;
+    }
+    const Payload payload = Shape::make(state);
+    if (!taposc::supports<Liblo>(payload)) {
+        state.SkipWithError("unsupported type tags!");
+        return;
+    }
+    std::vector<char> buffer(payload.packetSize());
+    // liblo grows its argument buffers by doubling, so four times the packet leaves room for every intermediate copy.
+    taposc::Arena arena(4 * payload.packetSize() + 4096);
+
+    size_t size = 0;
+    HeapMeter heap;
+    for (auto _ : state) {
+        {
+            taposc::ArenaScope scope(arena);
+            size = Liblo::serialize(payload, buffer.data(), buffer.size());
+        }
+        arena.reset();
+        if (size != buffer.size()) {
+            state.SkipWithError("size mismatch!");
+        }
+    }
+    heap.report(state);
+    setThroughput(state, size, 1);
+}
+
+BENCHMARK_TEMPLATE(BM_liblo_build, Empty)->Apply(Empty::sweep);
+BENCHMARK_TEMPLATE(BM_liblo_build, Int32Series)->Apply(Int32Series::sweep);
+BENCHMARK_TEMPLATE(BM_liblo_build, FloatSeries)->Apply(FloatSeries::sweep);
+BENCHMARK_TEMPLATE(BM_liblo_build, String)->Apply(String::sweep);
+BENCHMARK_TEMPLATE(BM_liblo_build, Blob)->Apply(Blob::sweep);
+BENCHMARK_TEMPLATE(BM_liblo_build, Mixed)->Apply(Mixed::sweep);
+BENCHMARK_TEMPLATE(BM_liblo_build, Corpus)->Apply(Corpus::sweep);
+
+BENCHMARK_TEMPLATE(BM_liblo_serialize_prebuilt, Empty)->Apply(Empty::sweep);
+BENCHMARK_TEMPLATE(BM_liblo_serialize_prebuilt, Int32Series)->Apply(Int32Series::sweep);
+BENCHMARK_TEMPLATE(BM_liblo_serialize_prebuilt, FloatSeries)->Apply(FloatSeries::sweep);
+BENCHMARK_TEMPLATE(BM_liblo_serialize_prebuilt, String)->Apply(String::sweep);
+BENCHMARK_TEMPLATE(BM_liblo_serialize_prebuilt, Blob)->Apply(Blob::sweep);
+BENCHMARK_TEMPLATE(BM_liblo_serialize_prebuilt, Mixed)->Apply(Mixed::sweep);
+BENCHMARK_TEMPLATE(BM_liblo_serialize_prebuilt, Corpus)->Apply(Corpus::sweep);
+
+BENCHMARK_TEMPLATE(BM_liblo_serialize_pooled, Empty)->Apply(Empty::sweep);
+BENCHMARK_TEMPLATE(BM_liblo_serialize_pooled, Int32Series)->Apply(Int32Series::sweep);
+BENCHMARK_TEMPLATE(BM_liblo_serialize_pooled, FloatSeries)->Apply(FloatSeries::sweep);
+BENCHMARK_TEMPLATE(BM_liblo_serialize_pooled, String)->Apply(String::sweep);
+BENCHMARK_TEMPLATE(BM_liblo_serialize_pooled, Blob)->Apply(Blob::sweep);
+BENCHMARK_TEMPLATE(BM_liblo_serialize_pooled, Mixed)->Apply(Mixed::sweep);
+BENCHMARK_TEMPLATE(BM_liblo_serialize_pooled, Corpus)->Apply(Corpus::sweep);
@@ -0,0 +1,289 @@
+#include "bench.h"
+#include "transports.h"
+
+#include "benchmark/benchmark.h"
+#include "ip/TimerListener.h"
+
+#include <sys/resource.h>
+
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Dispatch cost of oscpack's SocketReceiveMultiplexer as the number of attached sockets grows. One socket receives
+// every probe while the rest stay idle, as in a gateway listening on one port per device. Each iteration sends a
+// datagram and waits for the multiplexer thread to hand it to the listener, so ns/op is the round trip through the
+// notification mechanism and the dispatch scan.
+//
+// BM_multiplexer_timers measures the loop's timer bookkeeping instead: Run() is called on the benchmark thread with
+// only periodic timers attached, staggered across their period like per-device heartbeats, and returns once each has
+// fired. Time is CPU time, so the waits between expiries don't count.
+//
+// BM_multiplexer_large_packets sends datagrams up to 60 KB, past the default 4098 byte limit, to a multiplexer raised
+// to the 64 KiB maximum. The listener keeps the last kKeptPackets packets past ProcessPacket(), as a receiver handing
+// frames to another stage would: Copy copies each into a buffer it owns, Retain takes the multiplexer's pooled buffer
+// with RetainPacketBuffer() and releases the oldest one.
+
+namespace {
+
+struct SelectNotification {
+    static const SocketReceiveMultiplexer::NotificationMode mode = SocketReceiveMultiplexer::SELECT_NOTIFICATION;
+};
+
+struct EpollNotification {
+    static const SocketReceiveMultiplexer::NotificationMode mode = SocketReceiveMultiplexer::EPOLL_NOTIFICATION;
+};
+
+class CountingListener : public PacketListener {
+public:
+    void ProcessPacket(const char*, int, const IpEndpointName&) override {
+        packets.store(packets.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    std::atomic<int64_t> packets{0};
+};
+
+const size_t kKeptPackets = 64;
+
+struct Copy {
+    class Listener : public CountingListener {
+    public:
+        explicit Listener(SocketReceiveMultiplexer&) : m_kept(kKeptPackets) {}
+
+        void ProcessPacket(const char* data, int size, const IpEndpointName& remoteEndpoint) override {
+            m_kept[m_next].assign(data, data + size);
+            m_next = (m_next + 1) % kKeptPackets;
+            lastSize = size;
+            CountingListener::ProcessPacket(data, size, remoteEndpoint);
+        }
+
+        int lastSize = 0;
+
+    private:
+        std::vector<std::vector<char>> m_kept;
+        size_t m_next = 0;
+    };
+};
+
+struct Retain {
+    class Listener : public CountingListener {
+    public:
+        explicit Listener(SocketReceiveMultiplexer& multiplexer)
+                : m_multiplexer(multiplexer), m_kept(kKeptPackets, nullptr) {}
+
+        ~Listener() override {
+            for (char* data : m_kept) {
+                if (data) {
+                    m_multiplexer.ReleasePacketBuffer(data);
+                }
+            }
+        }
+
+        void ProcessPacket(const char* data, int size, const IpEndpointName& remoteEndpoint) override {
+            if (m_kept[m_next]) {
+                m_multiplexer.ReleasePacketBuffer(m_kept[m_next]);
+            }
+            m_kept[m_next] = m_multiplexer.RetainPacketBuffer();
+            m_next = (m_next + 1) % kKeptPackets;
+            lastSize = size;
+            CountingListener::ProcessPacket(data, size, remoteEndpoint);
+        }
+
+        int lastSize = 0;
+
+    private:
+        SocketReceiveMultiplexer& m_multiplexer;
+        std::vector<char*> m_kept;
+        size_t m_next = 0;
+    };
+};
+
+// Stops the multiplexer once |limit| expiries have been delivered across all attached listeners.
+class StoppingTimerListener : public TimerListener {
+public:
+    StoppingTimerListener(SocketReceiveMultiplexer& multiplexer, int64_t& expired, int64_t limit)
+            : m_multiplexer(multiplexer), m_expired(expired), m_limit(limit) {}
+
+    void TimerExpired() override {
+        if (++m_expired >= m_limit) {
+            m_multiplexer.Break();
+        }
+    }
+
+private:
+    SocketReceiveMultiplexer& m_multiplexer;
+    int64_t& m_expired;
+    int64_t m_limit;
+};
+
+// 1024 sockets exceed the usual soft limit on open descriptors.
+void raiseDescriptorLimit() {
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+} // namespace
+
+template <typename Notification>
+static void BM_multiplexer_dispatch(benchmark::State& state) {
+    raiseDescriptorLimit();
+
+    std::vector<std::unique_ptr<UdpSocket>> sockets;
+    int probedPort = 0;
+    try {
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            sockets.emplace_back(new UdpSocket());
+            probedPort = taposc::bindLoopback(*sockets.back());
+        }
+    } catch (const std::exception& e) {
+        state.SkipWithError(e.what());
+        return;
+    }
+
+    // The probed socket is attached last, so a linear scan reaches it last.
+    SocketReceiveMultiplexer multiplexer(Notification::mode);
+    CountingListener listener;
+    for (const std::unique_ptr<UdpSocket>& socket : sockets) {
+        multiplexer.AttachSocketListener(socket.get(), &listener);
+    }
+
+    std::string error;
+    std::atomic<bool> finished{false};
+    std::thread receiveThread([&] {
+        try {
+            multiplexer.Run();
+        } catch (const std::exception& e) {
+            error = e.what();
+        }
+        finished.store(true, std::memory_order_release);
+    });
+
+    UdpTransmitSocket sender(IpEndpointName("127.0.0.1", probedPort));
+    const char probe[16] = "/probe";
+    int64_t sent = 0;
+    for (auto _ : state) {
+        sender.Send(probe, sizeof(probe));
+        ++sent;
+        while (listener.packets.load(std::memory_order_acquire) < sent) {
+            if (finished.load(std::memory_order_acquire)) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+        if (finished.load(std::memory_order_acquire)) {
+            state.SkipWithError(error.empty() ? "multiplexer stopped!" : error.c_str());
+            break;
+        }
+    }
+
+    multiplexer.AsynchronousBreak();
+    receiveThread.join();
+    state.SetItemsProcessed(sent);
+}
+
+BENCHMARK_TEMPLATE(BM_multiplexer_dispatch, SelectNotification)
+        ->ArgName("sockets")->RangeMultiplier(4)->Range(1, 1024)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_multiplexer_dispatch, EpollNotification)
+        ->ArgName("sockets")->RangeMultiplier(4)->Range(1, 1024)->UseRealTime();
+
+template <typename Notification>
+static void BM_multiplexer_timers(benchmark::State& state) {
+    const int kPeriodMs = 20;
+    const int64_t timers = state.range(0);
+
+    SocketReceiveMultiplexer multiplexer(Notification::mode);
+    int64_t expired = 0;
+    std::deque<StoppingTimerListener> listeners;
+    for (int64_t i = 0; i < timers; ++i) {
+        listeners.emplace_back(multiplexer, expired, timers);
+        multiplexer.AttachPeriodicTimerListener(static_cast<int>(i % kPeriodMs), kPeriodMs, &listeners.back());
+    }
+
+    int64_t total = 0;
+    for (auto _ : state) {
+        expired = 0;
+        multiplexer.Run();
+        total += expired;
+    }
+
+    state.SetItemsProcessed(total);
+    state.counters["cpu/expiry"] = benchmark::Counter(static_cast<double>(total),
+            benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+BENCHMARK_TEMPLATE(BM_multiplexer_timers, SelectNotification)
+        ->ArgName("timers")->Arg(10)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_multiplexer_timers, EpollNotification)
+        ->ArgName("timers")->Arg(10)->Arg(100)->Arg(1000)->Arg(10000);
+
+template <typename Method>
+static void BM_multiplexer_large_packets(benchmark::State& state) {
+    const size_t size = state.range(0);
+
+    UdpSocket socket;
+    int port = 0;
+    try {
+        port = taposc::bindLoopback(socket);
+    } catch (const std::exception& e) {
+        state.SkipWithError(e.what());
+        return;
+    }
+
+    SocketReceiveMultiplexer multiplexer;
+    multiplexer.SetMaximumDatagramSize(SocketReceiveMultiplexer::MAX_DATAGRAM_SIZE);
+    // Declared after the multiplexer, so retained buffers are released before it is destroyed.
+    typename Method::Listener listener(multiplexer);
+    multiplexer.AttachSocketListener(&socket, &listener);
+
+    std::string error;
+    std::atomic<bool> finished{false};
+    std::thread receiveThread([&] {
+        try {
+            multiplexer.Run();
+        } catch (const std::exception& e) {
+            error = e.what();
+        }
+        finished.store(true, std::memory_order_release);
+    });
+
+    UdpTransmitSocket sender(IpEndpointName("127.0.0.1", port));
+    std::vector<char> packet(size);
+    for (size_t i = 0; i < size; ++i) {
+        packet[i] = static_cast<char>(i * 31);
+    }
+
+    int64_t sent = 0;
+    for (auto _ : state) {
+        sender.Send(packet.data(), packet.size());
+        ++sent;
+        while (listener.packets.load(std::memory_order_acquire) < sent) {
+            if (finished.load(std::memory_order_acquire)) {
+                break;
+            }
+            std::this_thread::yield();
+        }
+        if (finished.load(std::memory_order_acquire)) {
+            state.SkipWithError(error.empty() ? "multiplexer stopped!" : error.c_str());
+            break;
+        }
+    }
+
+    multiplexer.AsynchronousBreak();
+    receiveThread.join();
+    if (sent > 0 && listener.lastSize != static_cast<int>(size)) {
+        state.SkipWithError("packet truncated!");
+    }
+    setThroughput(state, size, 1);
+}
+
+BENCHMARK_TEMPLATE(BM_multiplexer_large_packets, Copy)
+        ->ArgName("bytes")->Arg(1024)->Arg(8192)->Arg(32768)->Arg(61440)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_multiplexer_large_packets, Retain)
+        ->ArgName("bytes")->Arg(1024)->Arg(8192)->Arg(32768)->Arg(61440)->UseRealTime();
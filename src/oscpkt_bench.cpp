@@ -0,0 +1,128 @@
+#include "bench.h"
+
+#include "adapters.h"
+#include "heap.h"
+
+#include <vector>
+
+using taposc::Oscpkt;
+
+// oscpkt's Message and PacketWriter each own a growing vector, so BM_serialize<Oscpkt, ...> mostly measures the
+// allocator. These show the encode cost without it: BM_oscpkt_serialize_reused keeps one Message and PacketWriter
+// across iterations so their vectors stay allocated, BM_oscpkt_serialize_buffer encodes into caller supplied buffers,
+// and BM_oscpkt_serialize_pooled runs the unchanged serialize path with the heap served by an Arena that is reset
+// every iteration.
+
+template <typename Shape>
+static void BM_oscpkt_serialize_reused(benchmark::State& state) {
+    const Payload payload = Shape::make(state);
+    if (!taposc::supports<Oscpkt>(payload)) {
+        state.SkipWithError("unsupported type tags!");
+        return;
+    }
+    oscpkt::Message message;
+    oscpkt::PacketWriter writer;
+    // Encode once before metering so the type tag string and argument index reach their final capacity.
+    message.init(payload.address());
+    Oscpkt::build(payload, message);
+    writer.init().addMessage(message);
+
+    size_t size = 0;
+    HeapMeter heap;
+    for (auto _ : state) {
+        message.init(payload.address());
+        Oscpkt::build(payload, message);
+        size = writer.init().addMessage(message).packetSize();
+        if (size != payload.packetSize()) {
+            state.SkipWithError("size mismatch!");
+        }
+    }
+    heap.report(state);
+    setThroughput(state, size, 1);
+}
+
+template <typename Shape>
+static void BM_oscpkt_serialize_buffer(benchmark::State& state) {
+    const Payload payload = Shape::make(state);
+    if (!taposc::supports<Oscpkt>(payload)) {
+        state.SkipWithError("unsupported type tags!");
+        return;
+    }
+    std::vector<char> arguments(payload.packetSize());
+    std::vector<char> buffer(payload.packetSize());
+    oscpkt::Message message;
+    message.useBuffer(arguments.data(), arguments.size());
+    oscpkt::PacketWriter writer(buffer.data(), buffer.size());
+    message.init(payload.address());
+    Oscpkt::build(payload, message);
+    writer.init().addMessage(message);
+
+    size_t size = 0;
+    HeapMeter heap;
+    for (auto _ : state) {
+        message.init(payload.address());
+        Oscpkt::build(payload, message);
+        size = writer.init().addMessage(message).packetSize();
+        if (size != buffer.size()) {
+            state.SkipWithError(writer.getErr() == oscpkt::BUFFER_OVERFLOW ? "buffer overflow!" : "size mismatch!");
+        }
+    }
+    heap.report(state);
+    setThroughput(state, size, 1);
+}
+
+template <typename Shape>
+static void BM_oscpkt_serialize_pooled(benchmark::State& state) {
+    if (!taposc::heapHooksInstalled()) {
+        state.SkipWithError("malloc interposition unavailable!");
+        return;
+    }
+    const Payload payload = Shape::make(state);
+    if (!taposc::supports<Oscpkt>(payload)) {
+        state.SkipWithError("unsupported type tags!");
+        return;
+    }
+    std::vector<char> buffer(payload.packetSize());
+    // Message's argument storage and type tags both grow by doubling, and the finished message is copied again into
+    // the PacketWriter; sixteen times the packet leaves room for every intermediate buffer.
+    taposc::Arena arena(16 * payload.packetSize() + 4096);
+
+    size_t size = 0;
+    HeapMeter heap;
+    for (auto _ : state) {
+        {
+            taposc::ArenaScope scope(arena);
+            size = Oscpkt::serialize(payload, buffer.data(), buffer.size());
+        }
+        arena.reset();
+        if (size != buffer.size()) {
+            state.SkipWithError("size mismatch!");
+        }
+    }
+    heap.report(state);
+    setThroughput(state, size, 1);
+}
+
+BENCHMARK_TEMPLATE(BM_oscpkt_serialize_reused, Empty)->Apply(Empty::sweep);
+BENCHMARK_TEMPLATE(BM_oscpkt_serialize_reused, Int32Series)->Apply(Int32Series::sweep);
+BENCHMARK_TEMPLATE(BM_oscpkt_serialize_reused, FloatSeries)->Apply(FloatSeries::sweep);
+BENCHMARK_TEMPLATE(BM_oscpkt_serialize_reused, String)->Apply(String::sweep);
+BENCHMARK_TEMPLATE(BM_oscpkt_serialize_reused, Blob)->Apply(Blob::sweep);
+BENCHMARK_TEMPLATE(BM_oscpkt_serialize_reused, Mixed)->Apply(Mixed::sweep);
+BENCHMARK_TEMPLATE(BM_oscpkt_serialize_reused, Corpus)->Apply(Corpus::sweep);
+
+BENCHMARK_TEMPLATE(BM_oscpkt_serialize_buffer, Empty)->Apply(Empty::sweep);
+BENCHMARK_TEMPLATE(BM_oscpkt_serialize_buffer, Int32Series)->Apply(Int32Series::sweep);
+BENCHMARK_TEMPLATE(BM_oscpkt_serialize_buffer, FloatSeries)->Apply(FloatSeries::sweep);
+BENCHMARK_TEMPLATE(BM_oscpkt_serialize_buffer, String)->Apply(String::sweep);
+BENCHMARK_TEMPLATE(BM_oscpkt_serialize_buffer, Blob)->Apply(Blob::sweep);
+BENCHMARK_TEMPLATE(BM_oscpkt_serialize_buffer, Mixed)->Apply(Mixed::sweep);
+BENCHMARK_TEMPLATE(BM_oscpkt_serialize_buffer, Corpus)->Apply(Corpus::sweep);
+
+BENCHMARK_TEMPLATE(BM_oscpkt_serialize_pooled, Empty)->Apply(Empty::sweep);
+BENCHMARK_TEMPLATE(BM_oscpkt_serialize_pooled, Int32Series)->Apply(Int32Series::sweep);
+BENCHMARK_TEMPLATE(BM_oscpkt_serialize_pooled, FloatSeries)->Apply(FloatSeries::sweep);
+BENCHMARK_TEMPLATE(BM_oscpkt_serialize_pooled, String)->Apply(String::sweep);
+BENCHMARK_TEMPLATE(BM_oscpkt_serialize_pooled, Blob)->Apply(Blob::sweep);
+BENCHMARK_TEMPLATE(BM_oscpkt_serialize_pooled, Mixed)->Apply(Mixed::sweep);
+BENCHMARK_TEMPLATE(BM_oscpkt_serialize_pooled, Corpus)->Apply(Corpus::sweep);
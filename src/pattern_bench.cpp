@@ -0,0 +1,95 @@
+#include "addresses.h"
+#include "bench.h"
+
+#include "oscpkt.hh"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Routing one incoming address against a table of handler patterns: oscpkt's interpreter, which re-parses each
+// pattern per call, against the same patterns compiled once with oscpkt::CompiledPattern, and against a whole
+// oscpkt::PatternSet. Each iteration routes one address and reports how many handlers it reached.
+
+namespace {
+
+const size_t kTrafficSize = 1024;
+
+void patternSweep(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"patterns", "wildcard_pct"});
+    for (int64_t patterns : {100, 2000}) {
+        for (int64_t wildcards : {0, 10, 50}) {
+            b->Args({patterns, wildcards});
+        }
+    }
+}
+
+struct Routes {
+    explicit Routes(benchmark::State& state)
+        : patterns(taposc::makeHandlerPatterns(state.range(0), static_cast<int>(state.range(1)), 1)),
+          traffic(taposc::makeTraffic(state.range(0), kTrafficSize, 2)) {}
+
+    std::vector<std::string> patterns;
+    std::vector<std::string> traffic;
+};
+
+void setMatches(benchmark::State& state, size_t matches) {
+    state.SetItemsProcessed(state.iterations());
+    state.counters["matches/address"] =
+            benchmark::Counter(static_cast<double>(matches), benchmark::Counter::kAvgIterations);
+}
+
+} // namespace
+
+static void BM_route_interpreted(benchmark::State& state) {
+    const Routes routes(state);
+
+    size_t matches = 0;
+    size_t next = 0;
+    for (auto _ : state) {
+        const std::string& address = routes.traffic[next++ % kTrafficSize];
+        for (const std::string& pattern : routes.patterns) {
+            matches += oscpkt::fullPatternMatch(pattern, address);
+        }
+    }
+    setMatches(state, matches);
+}
+
+static void BM_route_compiled(benchmark::State& state) {
+    const Routes routes(state);
+    std::vector<oscpkt::CompiledPattern> compiled;
+    for (const std::string& pattern : routes.patterns) {
+        compiled.emplace_back(pattern);
+    }
+
+    size_t matches = 0;
+    size_t next = 0;
+    for (auto _ : state) {
+        const char* address = routes.traffic[next++ % kTrafficSize].c_str();
+        for (const oscpkt::CompiledPattern& pattern : compiled) {
+            matches += pattern.matches(address);
+        }
+    }
+    setMatches(state, matches);
+}
+
+static void BM_route_pattern_set(benchmark::State& state) {
+    const Routes routes(state);
+    oscpkt::PatternSet set;
+    for (const std::string& pattern : routes.patterns) {
+        set.add(pattern);
+    }
+
+    std::vector<size_t> handlers;
+    size_t matches = 0;
+    size_t next = 0;
+    for (auto _ : state) {
+        matches += set.matchAll(routes.traffic[next++ % kTrafficSize].c_str(), handlers);
+        benchmark::DoNotOptimize(handlers.data());
+    }
+    setMatches(state, matches);
+}
+
+BENCHMARK(BM_route_interpreted)->Apply(patternSweep);
+BENCHMARK(BM_route_compiled)->Apply(patternSweep);
+BENCHMARK(BM_route_pattern_set)->Apply(patternSweep);
@@ -0,0 +1,135 @@
+#include "payload.h"
+
+#include <cstring>
+#include <utility>
+
+namespace {
+
+const char* dolorem = "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor "
+        "incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation ullamco "
+        "laboris nisi ut aliquip ex ea commodo consequat. Duis aute irure dolor in reprehenderit in voluptate velit "
+        "esse cillum dolore eu fugiat nulla pariatur. Excepteur sint occaecat cupidatat non proident, sunt in culpa "
+        "qui officia deserunt mollit anim id est laborum.";
+
+size_t roundUp4(size_t size) {
+    return (size + 3) & ~static_cast<size_t>(3);
+}
+
+} // namespace
+
+namespace taposc {
+
+Payload::Payload(const char* address) : m_address(address) {}
+
+void Payload::addInt32(int32_t value) {
+    append('i').i = value;
+}
+
+void Payload::addFloat(float value) {
+    append('f').f = value;
+}
+
+void Payload::addInt64(int64_t value) {
+    append('h').h = value;
+}
+
+void Payload::addDouble(double value) {
+    append('d').d = value;
+}
+
+void Payload::addTimeTag(uint64_t value) {
+    append('t').t = value;
+}
+
+void Payload::addBool(bool value) {
+    append(value ? 'T' : 'F');
+}
+
+void Payload::addNil() {
+    append('N');
+}
+
+void Payload::addInfinitum() {
+    append('I');
+}
+
+void Payload::beginArray() {
+    append('[');
+}
+
+void Payload::endArray() {
+    append(']');
+}
+
+void Payload::addString(size_t length) {
+    const size_t doloremLength = std::strlen(dolorem);
+    std::vector<char> string(length + 1, '\0');
+    for (size_t i = 0; i < length; ++i) {
+        string[i] = dolorem[i % doloremLength];
+    }
+    m_storage.push_back(std::move(string));
+    append('s').s = m_storage.back().data();
+}
+
+void Payload::addBlob(size_t size) {
+    std::vector<char> blob(size);
+    for (size_t i = 0; i < size; ++i) {
+        blob[i] = static_cast<char>(i);
+    }
+    m_storage.push_back(std::move(blob));
+    Argument& argument = append('b');
+    argument.blobData = m_storage.back().data();
+    argument.blobSize = static_cast<int32_t>(size);
+}
+
+size_t Payload::packetSize() const {
+    size_t size = roundUp4(m_address.size() + 1) + roundUp4(m_typeTags.size() + 2);
+    for (const Argument& argument : m_arguments) {
+        switch (argument.tag) {
+        case 'i':
+        case 'f':
+            size += 4;
+            break;
+        case 'h':
+        case 'd':
+        case 't':
+            size += 8;
+            break;
+        case 's':
+            size += roundUp4(std::strlen(argument.s) + 1);
+            break;
+        case 'b':
+            size += 4 + roundUp4(argument.blobSize);
+            break;
+        }
+    }
+    return size;
+}
+
+Argument& Payload::append(char tag) {
+    Argument argument = {};
+    argument.tag = tag;
+    m_arguments.push_back(argument);
+    m_typeTags.push_back(tag);
+    return m_arguments.back();
+}
+
+BundlePayload::BundlePayload(uint64_t timeTag, size_t groupSize) : m_timeTag(timeTag), m_groupSize(groupSize) {}
+
+void BundlePayload::addMessage(Payload&& message) {
+    m_messages.push_back(std::move(message));
+}
+
+size_t BundlePayload::packetSize() const {
+    // "#bundle\0" and the time tag, then a size prefix for each element.
+    size_t size = 16;
+    for (size_t i = 0; i < m_messages.size(); ++i) {
+        if (m_groupSize && i % m_groupSize == 0) {
+            size += 4 + 16;
+        }
+        size += 4 + m_messages[i].packetSize();
+    }
+    return size;
+}
+
+} // namespace taposc
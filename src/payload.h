@@ -0,0 +1,88 @@
+#ifndef SRC_PAYLOAD_H_
+#define SRC_PAYLOAD_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace taposc {
+
+// A single OSC argument. Only the fields matching |tag| are meaningful.
+struct Argument {
+    char tag;
+    int32_t i;
+    float f;
+    int64_t h;
+    double d;
+    uint64_t t;
+    const char* s;
+    const char* blobData;
+    int32_t blobSize;
+};
+
+// Library-neutral description of one OSC message. Every library adapter encodes the same Payload, so the
+// benchmarks compare identical messages. Strings and blobs are owned by the Payload, which is therefore move-only.
+class Payload {
+public:
+    explicit Payload(const char* address);
+    Payload(Payload&&) = default;
+    Payload& operator=(Payload&&) = default;
+    Payload(const Payload&) = delete;
+    Payload& operator=(const Payload&) = delete;
+
+    void addInt32(int32_t value);
+    void addFloat(float value);
+    void addInt64(int64_t value);
+    void addDouble(double value);
+    void addTimeTag(uint64_t value);
+    void addBool(bool value);
+    void addNil();
+    void addInfinitum();
+    // Array delimiters, which may nest.
+    void beginArray();
+    void endArray();
+    // Adds a string argument of |length| characters of filler text.
+    void addString(size_t length);
+    // Adds a blob argument of |size| bytes of filler data.
+    void addBlob(size_t size);
+
+    const char* address() const { return m_address.c_str(); }
+    const std::vector<Argument>& arguments() const { return m_arguments; }
+    // Type tags without the leading comma.
+    const std::string& typeTags() const { return m_typeTags; }
+    // Exact size in bytes of this message encoded as an OSC packet.
+    size_t packetSize() const;
+
+private:
+    Argument& append(char tag);
+
+    std::string m_address;
+    std::string m_typeTags;
+    std::vector<Argument> m_arguments;
+    std::vector<std::vector<char>> m_storage;
+};
+
+// An OSC bundle of messages. A nonzero |groupSize| nests each run of that many consecutive messages in an inner
+// bundle, otherwise all messages are direct elements of the outer bundle. Inner bundles share the outer time tag.
+class BundlePayload {
+public:
+    BundlePayload(uint64_t timeTag, size_t groupSize);
+
+    void addMessage(Payload&& message);
+
+    uint64_t timeTag() const { return m_timeTag; }
+    size_t groupSize() const { return m_groupSize; }
+    const std::vector<Payload>& messages() const { return m_messages; }
+    // Exact size in bytes of this bundle encoded as an OSC packet.
+    size_t packetSize() const;
+
+private:
+    uint64_t m_timeTag;
+    size_t m_groupSize;
+    std::vector<Payload> m_messages;
+};
+
+} // namespace taposc
+
+#endif // SRC_PAYLOAD_H_
@@ -0,0 +1,159 @@
+#include "transports.h"
+
+#include "benchmark/benchmark.h"
+
+#include "ip/UdpReceiverPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Receive throughput of oscpack's UdpReceiverPool as shards are added. Every shard is an SO_REUSEPORT socket on the
+// same port with its own multiplexer thread, pinned to its own CPU, and its own listener, which decodes each message
+// and counts it against the flow that sent it. kFlows sender threads each send from their own socket, so the kernel
+// spreads them across the shards by source port; with fewer flows than shards some shards stay idle.
+//
+// Each sender keeps at most kWindow packets in flight, so the socket buffers never overflow and packets/s is what the
+// receivers sustain. A packet that does not arrive within kLossTimeout is written off and counted in lost. Times are
+// wall clock: with perfect scaling items/s grows linearly with shards, up to the number of cores left for the senders.
+
+namespace {
+
+const char* const kAddress = "/bench/pool";
+const int kFlows = 8;
+const int64_t kWindow = 16;
+const int64_t kPacketsPerIteration = 1024;
+const std::chrono::milliseconds kLossTimeout(20);
+
+// One flow's progress, on its own cache line so that senders and shards don't false-share.
+struct alignas(64) FlowCounters {
+    std::atomic<int64_t> received{0};
+};
+
+class FlowListener : public PacketListener {
+public:
+    explicit FlowListener(FlowCounters* flows) : m_flows(flows) {}
+
+    void ProcessPacket(const char* data, int size, const IpEndpointName&) override {
+        try {
+            const osc::ReceivedMessage message(osc::ReceivedPacket(data, size));
+            osc::ReceivedMessageArgumentStream args = message.ArgumentStream();
+            osc::int32 flow;
+            osc::int32 sequence;
+            args >> flow >> sequence >> osc::EndMessage;
+            if (flow >= 0 && flow < kFlows) {
+                m_flows[flow].received.fetch_add(1, std::memory_order_release);
+            }
+        } catch (const osc::Exception&) {
+        }
+    }
+
+private:
+    FlowCounters* m_flows;
+};
+
+void shardSweep(benchmark::internal::Benchmark* b) {
+    const int cores = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    b->ArgNames({"shards", "flows"});
+    for (int shards = 1; shards <= std::max(cores, 4); shards *= 2) {
+        b->Args({shards, kFlows});
+    }
+    b->UseRealTime();
+}
+
+} // namespace
+
+static void BM_receiver_pool(benchmark::State& state) {
+    const size_t shardCount = state.range(0);
+
+    FlowCounters flows[kFlows];
+    std::vector<std::unique_ptr<FlowListener>> listeners;
+    std::vector<PacketListener*> listenerPointers;
+    for (size_t i = 0; i < shardCount; ++i) {
+        listeners.emplace_back(new FlowListener(flows));
+        listenerPointers.push_back(listeners.back().get());
+    }
+
+    // Finds a free port with one SO_REUSEPORT socket, then lets the pool join it before closing the probe socket, so
+    // no other process can take the port in between.
+    std::unique_ptr<UdpReceiverPool> pool;
+    int port = 0;
+    try {
+        UdpSocket probe;
+        probe.SetReusePort(true);
+        port = taposc::bindLoopback(probe);
+        pool.reset(new UdpReceiverPool(IpEndpointName("127.0.0.1", port), listenerPointers.data(), shardCount));
+        pool->Start();
+    } catch (const std::exception& e) {
+        state.SkipWithError(e.what());
+        return;
+    }
+
+    std::atomic<bool> stop{false};
+    std::atomic<int64_t> lost{0};
+    std::vector<std::thread> senders;
+    for (int flow = 0; flow < kFlows; ++flow) {
+        senders.emplace_back([&, flow] {
+            UdpTransmitSocket socket(IpEndpointName("127.0.0.1", port));
+            char buffer[64];
+            int64_t sent = 0;
+            int64_t writtenOff = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                const auto waitStart = std::chrono::steady_clock::now();
+                while (sent - writtenOff - flows[flow].received.load(std::memory_order_acquire) >= kWindow) {
+                    if (stop.load(std::memory_order_relaxed)) {
+                        return;
+                    }
+                    if (std::chrono::steady_clock::now() - waitStart > kLossTimeout) {
+                        const int64_t missing = sent - writtenOff - flows[flow].received.load();
+                        writtenOff += missing;
+                        lost.fetch_add(missing, std::memory_order_relaxed);
+                        break;
+                    }
+                    std::this_thread::yield();
+                }
+
+                osc::OutboundPacketStream p(buffer, sizeof(buffer));
+                p << osc::BeginMessage(kAddress) << static_cast<osc::int32>(flow)
+                  << static_cast<osc::int32>(sent) << osc::EndMessage;
+                socket.Send(p.Data(), p.Size());
+                ++sent;
+            }
+        });
+    }
+
+    auto received = [&] {
+        int64_t total = 0;
+        for (const FlowCounters& counters : flows) {
+            total += counters.received.load(std::memory_order_acquire);
+        }
+        return total;
+    };
+
+    int64_t target = received();
+    for (auto _ : state) {
+        target += kPacketsPerIteration;
+        while (received() < target) {
+            std::this_thread::yield();
+        }
+    }
+
+    stop.store(true);
+    for (std::thread& sender : senders) {
+        sender.join();
+    }
+    try {
+        pool->Stop();
+    } catch (const std::exception& e) {
+        state.SkipWithError(e.what());
+    }
+
+    state.SetItemsProcessed(state.iterations() * kPacketsPerIteration);
+    state.counters["lost"] = static_cast<double>(lost.load());
+}
+
+BENCHMARK(BM_receiver_pool)->Apply(shardSweep);
@@ -0,0 +1,192 @@
+#include "bench.h"
+
+#include "adapters.h"
+#include "capture.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using taposc::CapturedPacket;
+using taposc::CaptureReader;
+using taposc::Liblo;
+using taposc::Oscpack;
+using taposc::Oscpkt;
+using taposc::OscpktView;
+using taposc::Oscpp;
+
+// Replay mode: every packet of a capture file, mapped read-only and decoded in place by each library's consume(), or
+// consumeBundle() for bundles. Set TAPOSC_CAPTURE to the path of a capture recorded with CaptureRecorder to replay real
+// traffic; without it a synthetic capture is built from the corpus messages interleaved with cue bundles, one packet a
+// millisecond. Packets a library rejects, for instance the corpus messages with type tags it does not support, are
+// counted rather than failing the run; |rejected| is the fraction of packets decoded that were rejected.
+//
+// AsFastAsPossible decodes the packets back to back, wrapping around at the end of the capture, for packets/s and
+// bytes/s over the mix actually seen in production. OriginalTiming waits for each packet's recorded receive time before
+// decoding it, so caches and branch predictors are as cold as they are between real packets, and reports the decode
+// time alone: iteration time and the latency percentiles exclude the wait. Gaps longer than kMaxGap are shortened to it
+// so an idle stretch in the capture does not stall the run.
+
+namespace {
+
+const auto kMaxGap = std::chrono::milliseconds(100);
+const int64_t kTimedPackets = 2000;
+
+std::string buildSyntheticCapture() {
+    char path[] = "/tmp/taposc-replay-XXXXXX";
+    const int fd = mkstemp(path);
+    if (fd < 0) {
+        throw std::runtime_error("cannot create a temporary capture");
+    }
+    ::close(fd);
+
+    std::vector<std::vector<char>> packets;
+    for (size_t i = 0; i < taposc::corpusSize(); ++i) {
+        packets.push_back(Oscpack::encode(taposc::makeCorpusMessage(i)));
+    }
+    const size_t messageCount = packets.size();
+    for (size_t i = 0; i < messageCount; i += 4) {
+        packets.push_back(Oscpack::encodeBundle(makeCueBundle(10, 0)));
+    }
+
+    taposc::CaptureWriter writer(path);
+    const IpEndpointName sender("127.0.0.1", 9000);
+    for (int64_t round = 0; round < 16; ++round) {
+        for (size_t i = 0; i < packets.size(); ++i) {
+            const int64_t timeNs = (round * static_cast<int64_t>(packets.size()) + i) * 1000000;
+            writer.write(timeNs, packets[i].data(), packets[i].size(), sender);
+        }
+    }
+    writer.close();
+    return path;
+}
+
+// The capture shared by every replay benchmark, opened on first use. Throws if it cannot be opened or is empty.
+const CaptureReader& capture() {
+    static const std::unique_ptr<CaptureReader> reader = [] {
+        const char* path = std::getenv("TAPOSC_CAPTURE");
+        if (path && *path) {
+            return std::unique_ptr<CaptureReader>(new CaptureReader(path));
+        }
+        const std::string synthetic = buildSyntheticCapture();
+        std::unique_ptr<CaptureReader> mapped(new CaptureReader(synthetic));
+        ::unlink(synthetic.c_str());
+        return mapped;
+    }();
+    if (reader->packetCount() == 0) {
+        throw std::runtime_error("capture is empty");
+    }
+    return *reader;
+}
+
+// Some decoders throw on malformed packets or type tags they do not know; those count as rejected like the rest.
+template <typename Library>
+bool consumePacket(const CapturedPacket& packet, taposc::Sink& sink) {
+    try {
+        if (packet.size > 0 && packet.data[0] == '#') {
+            return Library::consumeBundle(packet.data, packet.size, sink) != 0;
+        }
+        return Library::consume(packet.data, packet.size, sink);
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+} // namespace
+
+struct AsFastAsPossible {};
+struct OriginalTiming {};
+
+template <typename Library>
+static void replay(benchmark::State& state, const CaptureReader& reader, AsFastAsPossible) {
+    const size_t count = reader.packetCount();
+    taposc::Sink sink;
+    int64_t rejected = 0;
+    int64_t bytes = 0;
+    size_t next = 0;
+    for (auto _ : state) {
+        const CapturedPacket packet = reader.packet(next);
+        if (!consumePacket<Library>(packet, sink)) {
+            ++rejected;
+        }
+        benchmark::DoNotOptimize(sink);
+        bytes += packet.size;
+        if (++next == count) {
+            next = 0;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(bytes);
+    state.counters["rejected"] = benchmark::Counter(static_cast<double>(rejected), benchmark::Counter::kAvgIterations);
+}
+
+template <typename Library>
+static void replay(benchmark::State& state, const CaptureReader& reader, OriginalTiming) {
+    const size_t count = reader.packetCount();
+    taposc::Sink sink;
+    taposc::LatencyHistogram latencies;
+    int64_t rejected = 0;
+    int64_t bytes = 0;
+    size_t next = 0;
+    int64_t previousNs = reader.packet(0).timeNs;
+    auto due = std::chrono::steady_clock::now();
+    for (auto _ : state) {
+        const CapturedPacket packet = reader.packet(next);
+        const int64_t gapNs = packet.timeNs > previousNs ? packet.timeNs - previousNs : 0;
+        due += std::min<std::chrono::nanoseconds>(std::chrono::nanoseconds(gapNs), kMaxGap);
+        previousNs = packet.timeNs;
+        std::this_thread::sleep_until(due);
+
+        const int64_t startNs = taposc::monotonicNs();
+        if (!consumePacket<Library>(packet, sink)) {
+            ++rejected;
+        }
+        benchmark::DoNotOptimize(sink);
+        const int64_t elapsedNs = taposc::monotonicNs() - startNs;
+        state.SetIterationTime(static_cast<double>(elapsedNs) * 1e-9);
+        latencies.record(elapsedNs);
+
+        bytes += packet.size;
+        if (++next == count) {
+            next = 0;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(bytes);
+    state.counters["rejected"] = benchmark::Counter(static_cast<double>(rejected), benchmark::Counter::kAvgIterations);
+    setLatency(state, latencies);
+}
+
+template <typename Library, typename Mode>
+static void BM_replay(benchmark::State& state) {
+    const CaptureReader* reader = nullptr;
+    try {
+        reader = &capture();
+    } catch (const std::exception& e) {
+        state.SkipWithError(e.what());
+        return;
+    }
+    state.counters["capture_packets"] = static_cast<double>(reader->packetCount());
+    replay<Library>(state, *reader, Mode());
+}
+
+BENCHMARK_TEMPLATE(BM_replay, Liblo, AsFastAsPossible);
+BENCHMARK_TEMPLATE(BM_replay, Oscpack, AsFastAsPossible);
+BENCHMARK_TEMPLATE(BM_replay, Oscpkt, AsFastAsPossible);
+BENCHMARK_TEMPLATE(BM_replay, OscpktView, AsFastAsPossible);
+BENCHMARK_TEMPLATE(BM_replay, Oscpp, AsFastAsPossible);
+
+BENCHMARK_TEMPLATE(BM_replay, Liblo, OriginalTiming)->Iterations(kTimedPackets)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_replay, Oscpack, OriginalTiming)->Iterations(kTimedPackets)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_replay, Oscpkt, OriginalTiming)->Iterations(kTimedPackets)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_replay, OscpktView, OriginalTiming)->Iterations(kTimedPackets)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_replay, Oscpp, OriginalTiming)->Iterations(kTimedPackets)->UseManualTime();
@@ -0,0 +1,171 @@
+#include "bench.h"
+#include "transports.h"
+
+#include "osc/ScheduledOscPacketListener.h"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <string>
+#include <thread>
+
+// oscpack's ScheduledOscPacketListener, which holds bundles until their time tag is due.
+//
+// BM_oscpack_schedule_bundles measures the scheduler's bookkeeping with |pending| bundles waiting, on a simulated
+// clock. Time tags are spread at random over a 200 ms window ahead of the clock, as cues sent with a lead would be, so
+// a bundle waits half the window on average. Each iteration schedules one more bundle, advances the clock by half the
+// window divided by |pending| and runs a timer tick, so on average one bundle falls due per iteration and the queue
+// stays at its size.
+//
+// BM_oscpack_schedule_lateness runs the scheduler on a SocketReceiveMultiplexer thread with a 1 ms timer and the
+// system clock. Bundles are sent every 100 us, tagged 50 ms ahead, and the lateness of each dispatch past its time
+// tag is reported as percentiles.
+
+namespace {
+
+const osc::uint64 kOneSecond = osc::uint64(1) << 32;
+const osc::uint64 kWindow = kOneSecond / 5;
+
+size_t encodeCue(char* buffer, size_t capacity, osc::uint64 timeTag, osc::int32 cue) {
+    osc::OutboundPacketStream p(buffer, capacity);
+    p << osc::BeginBundle(timeTag) << osc::BeginMessage("/cue/go") << cue << osc::EndMessage << osc::EndBundle;
+    return p.Size();
+}
+
+// Rewrites the time tag of a bundle encoded by encodeCue() in place.
+void setTimeTag(char* bundle, osc::uint64 timeTag) {
+    for (int i = 0; i < 8; ++i) {
+        bundle[8 + i] = static_cast<char>(timeTag >> (56 - 8 * i));
+    }
+}
+
+class SimulatedScheduler : public osc::ScheduledOscPacketListener {
+public:
+    osc::uint64 now = osc::uint64(3900000000) << 32;
+    int64_t dispatched = 0;
+
+protected:
+    osc::uint64 CurrentTimeTag() override { return now; }
+
+    void ProcessMessage(const osc::ReceivedMessage&, const IpEndpointName&) override { ++dispatched; }
+};
+
+class MeasuringScheduler : public osc::ScheduledOscPacketListener {
+public:
+    osc::uint64 currentTimeTag() { return CurrentTimeTag(); }
+
+    std::atomic<int64_t> dispatched{0};
+    taposc::LatencyHistogram latenessNs;
+
+protected:
+    void BundleDispatched(osc::uint64, osc::int64 latenessNanoseconds) override {
+        latenessNs.record(latenessNanoseconds > 0 ? latenessNanoseconds : 0);
+    }
+
+    void ProcessMessage(const osc::ReceivedMessage&, const IpEndpointName&) override {
+        dispatched.store(dispatched.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+};
+
+// xorshift64, cheap enough not to show up next to the scheduler.
+osc::uint64 nextRandom(osc::uint64& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+} // namespace
+
+static void BM_oscpack_schedule_bundles(benchmark::State& state) {
+    const osc::uint64 pending = state.range(0);
+    const IpEndpointName sender("127.0.0.1", 9000);
+
+    SimulatedScheduler scheduler;
+    char bundle[64];
+    const size_t size = encodeCue(bundle, sizeof(bundle), 1, 1);
+    osc::uint64 random = 0x9E3779B97F4A7C15ULL;
+    // Prefill with the steady-state remaining waits rather than fresh ones: a bundle is still queued with probability
+    // falling linearly over the window, so its remaining wait is distributed like the lesser of two uniform draws.
+    for (osc::uint64 i = 0; i < pending; ++i) {
+        const osc::uint64 first = nextRandom(random) % kWindow;
+        const osc::uint64 second = nextRandom(random) % kWindow;
+        setTimeTag(bundle, scheduler.now + 1 + (first < second ? first : second));
+        scheduler.ProcessPacket(bundle, static_cast<int>(size), sender);
+    }
+
+    const osc::uint64 step = kWindow / 2 / pending;
+    HeapMeter heap;
+    for (auto _ : state) {
+        setTimeTag(bundle, scheduler.now + 1 + nextRandom(random) % kWindow);
+        scheduler.ProcessPacket(bundle, static_cast<int>(size), sender);
+        scheduler.now += step;
+        scheduler.TimerExpired();
+    }
+    heap.report(state);
+
+    state.SetItemsProcessed(scheduler.dispatched);
+    state.counters["pending"] = static_cast<double>(scheduler.PendingBundleCount());
+}
+
+BENCHMARK(BM_oscpack_schedule_bundles)->ArgName("pending")->Arg(1000)->Arg(10000)->Arg(100000);
+
+static void BM_oscpack_schedule_lateness(benchmark::State& state) {
+    const auto kInterval = std::chrono::microseconds(100);
+    const osc::uint64 kLead = kOneSecond / 20;
+
+    UdpSocket socket;
+    int port = 0;
+    try {
+        port = taposc::bindLoopback(socket);
+    } catch (const std::exception& e) {
+        state.SkipWithError(e.what());
+        return;
+    }
+
+    SocketReceiveMultiplexer multiplexer;
+    MeasuringScheduler scheduler;
+    multiplexer.AttachSocketListener(&socket, &scheduler);
+    multiplexer.AttachPeriodicTimerListener(1, &scheduler);
+
+    std::string error;
+    std::thread receiveThread([&] {
+        try {
+            multiplexer.Run();
+        } catch (const std::exception& e) {
+            error = e.what();
+        }
+    });
+
+    UdpTransmitSocket sender(IpEndpointName("127.0.0.1", port));
+    char bundle[64];
+    int64_t sent = 0;
+    auto nextSend = std::chrono::steady_clock::now();
+    for (auto _ : state) {
+        std::this_thread::sleep_until(nextSend);
+        nextSend += kInterval;
+        const size_t size = encodeCue(bundle, sizeof(bundle), scheduler.currentTimeTag() + kLead,
+                static_cast<osc::int32>(sent));
+        sender.Send(bundle, size);
+        ++sent;
+    }
+
+    // Every bundle is due within the lead; allow for a few lost on loopback.
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (scheduler.dispatched.load(std::memory_order_acquire) < sent &&
+            std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    multiplexer.AsynchronousBreak();
+    receiveThread.join();
+    if (!error.empty()) {
+        state.SkipWithError(error.c_str());
+    }
+
+    state.SetItemsProcessed(scheduler.dispatched.load());
+    state.counters["lost"] = static_cast<double>(sent - scheduler.dispatched.load());
+    setLatency(state, scheduler.latenessNs);
+}
+
+BENCHMARK(BM_oscpack_schedule_lateness)->Iterations(5000)->UseRealTime();
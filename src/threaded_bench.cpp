@@ -0,0 +1,129 @@
+#include "bench.h"
+
+#include "adapters.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using taposc::Liblo;
+using taposc::Oscpack;
+using taposc::Oscpkt;
+using taposc::Oscpp;
+
+// Multi-threaded variants of the serialize, deserialize and consume benchmarks. Every thread builds its own payload
+// and buffers inside the benchmark function, so the only contention is whatever the library and the allocator
+// introduce. Times are wall clock, so a flat ns/op across thread counts means perfect scaling.
+
+namespace {
+
+const int kMaxThreads = 256;
+
+void threadSweep(benchmark::internal::Benchmark* b) {
+    const int threads = static_cast<int>(std::thread::hardware_concurrency());
+    b->ThreadRange(1, std::min(std::max(threads, 1), kMaxThreads))->UseRealTime();
+}
+
+// Per-thread results stored next to each other, so neighbouring threads write to the same cache line.
+struct PackedSinks {
+    taposc::Sink sinks[kMaxThreads];
+
+    taposc::Sink& at(int thread) { return sinks[thread]; }
+};
+
+// The same results, each on its own cache line.
+struct PaddedSinks {
+    struct alignas(64) Slot {
+        taposc::Sink sink;
+    };
+    Slot slots[kMaxThreads];
+
+    taposc::Sink& at(int thread) { return slots[thread].sink; }
+};
+
+} // namespace
+
+template <typename Library, typename Shape>
+static void BM_serialize_threaded(benchmark::State& state) {
+    const Payload payload = Shape::make(state);
+    if (!taposc::supports<Library>(payload)) {
+        state.SkipWithError("unsupported type tags!");
+        return;
+    }
+    std::vector<char> buffer(payload.packetSize());
+
+    size_t size = 0;
+    HeapMeter heap;
+    for (auto _ : state) {
+        size = Library::serialize(payload, buffer.data(), buffer.size());
+        if (size != buffer.size()) {
+            state.SkipWithError("size mismatch!");
+        }
+    }
+    heap.report(state);
+    setThroughput(state, size, 1);
+}
+
+template <typename Library, typename Shape>
+static void BM_deserialize_threaded(benchmark::State& state) {
+    const Payload payload = Shape::make(state);
+    if (!taposc::supports<Library>(payload)) {
+        state.SkipWithError("unsupported type tags!");
+        return;
+    }
+    const std::vector<char> packet = Library::encode(payload);
+
+    HeapMeter heap;
+    for (auto _ : state) {
+        if (!Library::deserialize(packet.data(), packet.size())) {
+            state.SkipWithError("not message!");
+        }
+    }
+    heap.report(state);
+    setThroughput(state, packet.size(), 1);
+}
+
+// Shared-state variant: each thread decodes its own packet but accumulates into a process-wide array of sinks laid
+// out by |Sinks|, so PackedSinks against PaddedSinks isolates the cost of false sharing on the decode path.
+template <typename Library, typename Shape, typename Sinks>
+static void BM_consume_shared(benchmark::State& state) {
+    static Sinks sinks;
+
+    const Payload payload = Shape::make(state);
+    if (!taposc::supports<Library>(payload)) {
+        state.SkipWithError("unsupported type tags!");
+        return;
+    }
+    const std::vector<char> packet = Library::encode(payload);
+
+    taposc::Sink& sink = sinks.at(state.thread_index());
+    HeapMeter heap;
+    for (auto _ : state) {
+        if (!Library::consume(packet.data(), packet.size(), sink)) {
+            state.SkipWithError("not message!");
+        }
+        benchmark::DoNotOptimize(sink);
+    }
+    heap.report(state);
+    setThroughput(state, packet.size(), 1);
+}
+
+BENCHMARK_TEMPLATE(BM_serialize_threaded, Liblo, Corpus)->Apply(Corpus::sweep)->Apply(threadSweep);
+BENCHMARK_TEMPLATE(BM_deserialize_threaded, Liblo, Corpus)->Apply(Corpus::sweep)->Apply(threadSweep);
+BENCHMARK_TEMPLATE(BM_consume_shared, Liblo, Corpus, PackedSinks)->Apply(Corpus::sweep)->Apply(threadSweep);
+BENCHMARK_TEMPLATE(BM_consume_shared, Liblo, Corpus, PaddedSinks)->Apply(Corpus::sweep)->Apply(threadSweep);
+
+BENCHMARK_TEMPLATE(BM_serialize_threaded, Oscpack, Corpus)->Apply(Corpus::sweep)->Apply(threadSweep);
+BENCHMARK_TEMPLATE(BM_deserialize_threaded, Oscpack, Corpus)->Apply(Corpus::sweep)->Apply(threadSweep);
+BENCHMARK_TEMPLATE(BM_consume_shared, Oscpack, Corpus, PackedSinks)->Apply(Corpus::sweep)->Apply(threadSweep);
+BENCHMARK_TEMPLATE(BM_consume_shared, Oscpack, Corpus, PaddedSinks)->Apply(Corpus::sweep)->Apply(threadSweep);
+
+BENCHMARK_TEMPLATE(BM_serialize_threaded, Oscpkt, Corpus)->Apply(Corpus::sweep)->Apply(threadSweep);
+BENCHMARK_TEMPLATE(BM_deserialize_threaded, Oscpkt, Corpus)->Apply(Corpus::sweep)->Apply(threadSweep);
+BENCHMARK_TEMPLATE(BM_consume_shared, Oscpkt, Corpus, PackedSinks)->Apply(Corpus::sweep)->Apply(threadSweep);
+BENCHMARK_TEMPLATE(BM_consume_shared, Oscpkt, Corpus, PaddedSinks)->Apply(Corpus::sweep)->Apply(threadSweep);
+
+BENCHMARK_TEMPLATE(BM_serialize_threaded, Oscpp, Corpus)->Apply(Corpus::sweep)->Apply(threadSweep);
+BENCHMARK_TEMPLATE(BM_deserialize_threaded, Oscpp, Corpus)->Apply(Corpus::sweep)->Apply(threadSweep);
+BENCHMARK_TEMPLATE(BM_consume_shared, Oscpp, Corpus, PackedSinks)->Apply(Corpus::sweep)->Apply(threadSweep);
+BENCHMARK_TEMPLATE(BM_consume_shared, Oscpp, Corpus, PaddedSinks)->Apply(Corpus::sweep)->Apply(threadSweep);
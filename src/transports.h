@@ -0,0 +1,485 @@
+#ifndef SRC_TRANSPORTS_H_
+#define SRC_TRANSPORTS_H_
+
+#include "histogram.h"
+
+#include "ip/PacketListener.h"
+#include "ip/UdpSocket.h"
+#include "osc/OscOutboundPacketStream.h"
+#include "osc/OscReceivedElements.h"
+#include "oscpkt.hh"
+
+// udp.hh relies on its includer for these.
+#include <ostream>
+#include <unistd.h>
+
+#include "udp.hh"
+
+extern "C" {
+#include "lo/lo.h"
+}
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Per-library UDP transports used as template arguments by the loopback benchmarks. Each transport provides:
+//
+//   Receiver - binds a socket on 127.0.0.1 on construction and exposes port(). run(log) receives and decodes probes
+//       through the library's own socket and dispatch code, recording each into |log|, and returns once it decodes a
+//       probe with a negative sequence number.
+//   Sender(port, packetSize) - connects to |port| on 127.0.0.1. send(sequence, sentNs) encodes a probe padded to
+//       |packetSize| bytes with the library's encoder and sends it, or queues it if the transport sends in batches.
+//       flush() sends anything still queued.
+//
+// Both report setup failures through isOk(); oscpack additionally throws std::runtime_error from its socket calls.
+// A probe is the message "/bench/udp" with an int32 sequence number, an int64 send time and a padding blob.
+
+namespace taposc {
+
+const char* const kProbeAddress = "/bench/udp";
+// Encoded size of a probe with an empty padding blob.
+const size_t kProbeOverhead = 36;
+// Datagrams moved per system call by the batched transports.
+const size_t kBatchSize = 32;
+// Receive slot size of the batched transports, large enough for any UDP datagram.
+const size_t kMaxDatagramSize = 65536;
+
+// What the receive thread observed. Only the receive thread writes it while running, apart from |packets|, which
+// the sending thread polls to see when the socket has drained.
+struct ReceiveLog {
+    void record(int64_t sentNs) {
+        const int64_t latencyNs = monotonicNs() - sentNs;
+        latenciesNs.record(latencyNs > 0 ? latencyNs : 0);
+        packets.store(packets.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    std::atomic<int64_t> packets{0};
+    int64_t malformed = 0;
+    // Heap allocations made by the receiving thread while it ran.
+    uint64_t allocations = 0;
+    LatencyHistogram latenciesNs;
+};
+
+// Binds |socket| to a free port on 127.0.0.1 and returns the port. oscpack cannot report an ephemeral port:
+// LocalEndpointFor() disconnects the socket afterwards, which also releases a port the kernel picked. So ports are
+// tried in turn, continuing from the last one handed out.
+inline int bindLoopback(UdpSocket& socket) {
+    static int nextPort = 20000;
+    for (int attempt = 0;; ++attempt) {
+        const int port = nextPort;
+        nextPort = nextPort == 59999 ? 20000 : nextPort + 1;
+        try {
+            socket.Bind(IpEndpointName("127.0.0.1", port));
+            return port;
+        } catch (const std::runtime_error&) {
+            if (attempt == 40000) {
+                throw;
+            }
+        }
+    }
+}
+
+struct OscpackUdp {
+    class Receiver : public PacketListener {
+    public:
+        Receiver() : Receiver(SocketReceiveMultiplexer::SELECT_NOTIFICATION) {}
+
+        explicit Receiver(SocketReceiveMultiplexer::NotificationMode mode)
+                : m_multiplexer(mode), m_port(bindLoopback(m_socket)) {
+            m_multiplexer.AttachSocketListener(&m_socket, this);
+        }
+
+        ~Receiver() { m_multiplexer.DetachSocketListener(&m_socket, this); }
+
+        bool isOk() const { return m_socket.IsBound(); }
+        int port() const { return m_port; }
+
+        void run(ReceiveLog& log) {
+            m_log = &log;
+            m_multiplexer.Run();
+        }
+
+        void ProcessPacket(const char* data, int size, const IpEndpointName&) override {
+            if (!OscpackUdp::record(data, size, *m_log)) {
+                m_multiplexer.Break();
+            }
+        }
+
+    private:
+        UdpSocket m_socket;
+        SocketReceiveMultiplexer m_multiplexer;
+        int m_port;
+        ReceiveLog* m_log = nullptr;
+    };
+
+    class Sender {
+    public:
+        Sender(int port, size_t packetSize)
+            : m_socket(IpEndpointName("127.0.0.1", port)),
+              m_buffer(packetSize),
+              m_padding(packetSize - kProbeOverhead) {}
+
+        bool isOk() const { return true; }
+
+        void send(int32_t sequence, int64_t sentNs) {
+            const size_t size = OscpackUdp::encode(m_buffer.data(), m_buffer.size(), m_padding, sequence, sentNs);
+            m_socket.Send(m_buffer.data(), size);
+        }
+
+        void flush() {}
+
+    private:
+        UdpTransmitSocket m_socket;
+        std::vector<char> m_buffer;
+        std::vector<char> m_padding;
+    };
+
+    // Decodes a probe into |log|, returning false for the probe that ends the run.
+    static bool record(const char* data, size_t size, ReceiveLog& log) {
+        try {
+            const osc::ReceivedPacket packet(data, static_cast<osc::osc_bundle_element_size_t>(size));
+            const osc::ReceivedMessage message(packet);
+            osc::ReceivedMessageArgumentStream args = message.ArgumentStream();
+            osc::int32 sequence;
+            osc::int64 sentNs;
+            args >> sequence >> sentNs;
+            if (sequence < 0) {
+                return false;
+            }
+            log.record(sentNs);
+        } catch (const osc::Exception&) {
+            ++log.malformed;
+        }
+        return true;
+    }
+
+    static size_t encode(char* buffer, size_t capacity, const std::vector<char>& padding, int32_t sequence,
+            int64_t sentNs) {
+        osc::OutboundPacketStream p(buffer, capacity);
+        p << osc::BeginMessage(kProbeAddress) << static_cast<osc::int32>(sequence) << static_cast<osc::int64>(sentNs)
+          << osc::Blob(padding.data(), static_cast<osc::osc_bundle_element_size_t>(padding.size())) << osc::EndMessage;
+        return p.Size();
+    }
+};
+
+// OscpackUdp with the multiplexer waiting in epoll instead of select(), where it is available.
+struct OscpackEpollUdp : OscpackUdp {
+    class Receiver : public OscpackUdp::Receiver {
+    public:
+        Receiver() : OscpackUdp::Receiver(SocketReceiveMultiplexer::EPOLL_NOTIFICATION) {}
+    };
+};
+
+// oscpack receiving with UdpSocket::ReceiveBatch() on its own thread instead of through a SocketReceiveMultiplexer,
+// and sending kBatchSize probes per UdpSocket::SendBatch(). Queued probes are timestamped when queued, so latency
+// includes the time spent waiting for the batch to fill.
+struct OscpackBatchUdp {
+    class Receiver {
+    public:
+        Receiver() : m_port(bindLoopback(m_socket)), m_buffer(kBatchSize * kMaxDatagramSize) {
+            for (size_t i = 0; i < kBatchSize; ++i) {
+                m_datagrams[i].data = &m_buffer[i * kMaxDatagramSize];
+                m_datagrams[i].capacity = kMaxDatagramSize;
+            }
+        }
+
+        bool isOk() const { return m_socket.IsBound(); }
+        int port() const { return m_port; }
+
+        void run(ReceiveLog& log) {
+            for (;;) {
+                const size_t count = m_socket.ReceiveBatch(m_datagrams, kBatchSize);
+                for (size_t i = 0; i < count; ++i) {
+                    if (!OscpackUdp::record(m_datagrams[i].data, m_datagrams[i].size, log)) {
+                        return;
+                    }
+                }
+            }
+        }
+
+    private:
+        UdpSocket m_socket;
+        int m_port;
+        std::vector<char> m_buffer;
+        UdpDatagram m_datagrams[kBatchSize];
+    };
+
+    class Sender {
+    public:
+        Sender(int port, size_t packetSize)
+            : m_socket(IpEndpointName("127.0.0.1", port)),
+              m_buffer(kBatchSize * packetSize),
+              m_padding(packetSize - kProbeOverhead),
+              m_queued(0) {
+            for (size_t i = 0; i < kBatchSize; ++i) {
+                m_datagrams[i].data = &m_buffer[i * packetSize];
+                m_datagrams[i].capacity = packetSize;
+            }
+        }
+
+        bool isOk() const { return true; }
+
+        void send(int32_t sequence, int64_t sentNs) {
+            UdpDatagram& datagram = m_datagrams[m_queued];
+            datagram.size = OscpackUdp::encode(datagram.data, datagram.capacity, m_padding, sequence, sentNs);
+            if (++m_queued == kBatchSize) {
+                flush();
+            }
+        }
+
+        void flush() {
+            if (m_queued) {
+                m_socket.SendBatch(m_datagrams, m_queued);
+                m_queued = 0;
+            }
+        }
+
+    private:
+        UdpTransmitSocket m_socket;
+        std::vector<char> m_buffer;
+        std::vector<char> m_padding;
+        UdpDatagram m_datagrams[kBatchSize];
+        size_t m_queued;
+    };
+};
+
+struct OscpktUdp {
+    class Receiver {
+    public:
+        Receiver() { m_socket.bindTo(0); }
+
+        bool isOk() const { return m_socket.isOk(); }
+        int port() const { return m_socket.boundPort(); }
+
+        void run(ReceiveLog& log) {
+            while (m_socket.isOk()) {
+                if (m_socket.receiveNextPacket()
+                        && !OscpktUdp::record(m_reader, m_socket.packetData(), m_socket.packetSize(), log)) {
+                    return;
+                }
+            }
+        }
+
+    private:
+        oscpkt::UdpSocket m_socket;
+        oscpkt::PacketReader m_reader;
+    };
+
+    class Sender {
+    public:
+        Sender(int port, size_t packetSize) : m_padding(packetSize - kProbeOverhead) {
+            m_socket.connectTo("127.0.0.1", port);
+        }
+
+        bool isOk() const { return m_socket.isOk(); }
+
+        void send(int32_t sequence, int64_t sentNs) {
+            OscpktUdp::encode(m_message, m_writer, m_padding, sequence, sentNs);
+            m_socket.sendPacket(m_writer.packetData(), m_writer.packetSize());
+        }
+
+        void flush() {}
+
+    private:
+        oscpkt::UdpSocket m_socket;
+        oscpkt::Message m_message;
+        oscpkt::PacketWriter m_writer;
+        std::vector<char> m_padding;
+    };
+
+    // Decodes a probe into |log| with a PacketReader or PacketReaderView, returning false for the probe that ends
+    // the run.
+    template <typename Reader>
+    static bool record(Reader& reader, const void* data, size_t size, ReceiveLog& log) {
+        reader.init(data, size);
+        auto* message = reader.popMessage();
+        int32_t sequence;
+        int64_t sentNs;
+        if (!message || !message->arg().popInt32(sequence).popInt64(sentNs).isOk()) {
+            ++log.malformed;
+            return true;
+        }
+        if (sequence < 0) {
+            return false;
+        }
+        log.record(sentNs);
+        return true;
+    }
+
+    static void encode(oscpkt::Message& message, oscpkt::PacketWriter& writer, std::vector<char>& padding,
+            int32_t sequence, int64_t sentNs) {
+        message.init(kProbeAddress).pushInt32(sequence).pushInt64(sentNs).pushBlob(padding.data(), padding.size());
+        writer.init().addMessage(message);
+    }
+};
+
+// oscpkt receiving through UdpSocket::enableReceiveRing() and decoding with PacketReaderView, so each datagram is
+// read into a preallocated slot and decoded in place without touching the heap.
+struct OscpktRingUdp {
+    class Receiver {
+    public:
+        Receiver() {
+            m_socket.bindTo(0);
+            m_socket.enableReceiveRing(kRingSlots);
+        }
+
+        bool isOk() const { return m_socket.isOk(); }
+        int port() const { return m_socket.boundPort(); }
+
+        void run(ReceiveLog& log) {
+            while (m_socket.isOk()) {
+                if (m_socket.receiveNextPacket()
+                        && !OscpktUdp::record(m_reader, m_socket.packetData(), m_socket.packetSize(), log)) {
+                    return;
+                }
+            }
+        }
+
+    private:
+        static const int kRingSlots = 8;
+
+        oscpkt::UdpSocket m_socket;
+        oscpkt::PacketReaderView m_reader;
+    };
+
+    typedef OscpktUdp::Sender Sender;
+};
+
+// oscpkt receiving with UdpSocket::receiveNextPackets() and sending through its queue, flushed every kBatchSize
+// probes. As with OscpackBatchUdp, latency includes the time a probe waits for its batch to fill.
+struct OscpktBatchUdp {
+    class Receiver {
+    public:
+        Receiver() { m_socket.bindTo(0); }
+
+        bool isOk() const { return m_socket.isOk(); }
+        int port() const { return m_socket.boundPort(); }
+
+        void run(ReceiveLog& log) {
+            while (m_socket.isOk()) {
+                const int count = m_socket.receiveNextPackets(static_cast<int>(kBatchSize));
+                for (int i = 0; i < count; ++i) {
+                    if (!OscpktUdp::record(m_reader, m_socket.batchPacketData(i), m_socket.batchPacketSize(i), log)) {
+                        return;
+                    }
+                }
+            }
+        }
+
+    private:
+        oscpkt::UdpSocket m_socket;
+        oscpkt::PacketReader m_reader;
+    };
+
+    class Sender {
+    public:
+        Sender(int port, size_t packetSize) : m_padding(packetSize - kProbeOverhead) {
+            m_socket.connectTo("127.0.0.1", port);
+        }
+
+        bool isOk() const { return m_socket.isOk(); }
+
+        void send(int32_t sequence, int64_t sentNs) {
+            OscpktUdp::encode(m_message, m_writer, m_padding, sequence, sentNs);
+            m_socket.queuePacket(m_writer.packetData(), m_writer.packetSize());
+            if (m_socket.queuedPacketCount() == kBatchSize) {
+                flush();
+            }
+        }
+
+        void flush() { m_socket.flushQueuedPackets(); }
+
+    private:
+        oscpkt::UdpSocket m_socket;
+        oscpkt::Message m_message;
+        oscpkt::PacketWriter m_writer;
+        std::vector<char> m_padding;
+    };
+};
+
+struct LibloUdp {
+    class Receiver {
+    public:
+        Receiver() : m_server(lo_server_new_with_proto(nullptr, LO_UDP, nullptr)) {
+            if (m_server) {
+                lo_server_add_method(m_server, kProbeAddress, "ihb", &Receiver::handle, this);
+            }
+        }
+
+        ~Receiver() {
+            if (m_server) {
+                lo_server_free(m_server);
+            }
+        }
+
+        Receiver(const Receiver&) = delete;
+        Receiver& operator=(const Receiver&) = delete;
+
+        bool isOk() const { return m_server != nullptr; }
+        int port() const { return lo_server_get_port(m_server); }
+
+        void run(ReceiveLog& log) {
+            m_log = &log;
+            m_done = false;
+            while (!m_done) {
+                lo_server_recv(m_server);
+            }
+        }
+
+    private:
+        static int handle(const char*, const char*, lo_arg** argv, int, lo_message, void* userData) {
+            Receiver* self = static_cast<Receiver*>(userData);
+            if (argv[0]->i < 0) {
+                self->m_done = true;
+            } else {
+                self->m_log->record(argv[1]->h);
+            }
+            return 0;
+        }
+
+        lo_server m_server;
+        ReceiveLog* m_log = nullptr;
+        bool m_done = false;
+    };
+
+    class Sender {
+    public:
+        Sender(int port, size_t packetSize) : m_address(lo_address_new("127.0.0.1", std::to_string(port).c_str())) {
+            const std::vector<char> padding(packetSize - kProbeOverhead);
+            m_padding = lo_blob_new(static_cast<int32_t>(padding.size()), padding.data());
+        }
+
+        ~Sender() {
+            lo_blob_free(m_padding);
+            lo_address_free(m_address);
+        }
+
+        Sender(const Sender&) = delete;
+        Sender& operator=(const Sender&) = delete;
+
+        bool isOk() const { return m_address && m_padding; }
+
+        void send(int32_t sequence, int64_t sentNs) {
+            lo_message message = lo_message_new();
+            lo_message_add_int32(message, sequence);
+            lo_message_add_int64(message, sentNs);
+            lo_message_add_blob(message, m_padding);
+            lo_send_message(m_address, kProbeAddress, message);
+            lo_message_free(message);
+        }
+
+        void flush() {}
+
+    private:
+        lo_address m_address;
+        lo_blob m_padding;
+    };
+};
+
+} // namespace taposc
+
+#endif // SRC_TRANSPORTS_H_
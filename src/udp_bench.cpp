@@ -0,0 +1,116 @@
+#include "heap.h"
+#include "transports.h"
+
+#include "benchmark/benchmark.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <thread>
+
+using taposc::LibloUdp;
+using taposc::OscpackBatchUdp;
+using taposc::OscpackEpollUdp;
+using taposc::OscpackUdp;
+using taposc::OscpktBatchUdp;
+using taposc::OscpktRingUdp;
+using taposc::OscpktUdp;
+
+// End-to-end loopback benchmarks: a sender on the benchmark thread and a receiver on its own thread exchange probes
+// over 127.0.0.1 through each library's socket, dispatch and codec. Each iteration sends one probe, optionally paced to
+// a fixed rate. Sent and received rates, the fraction of probes dropped and the one-way latency percentiles are
+// reported as counters, along with the heap allocations the receiving thread made per packet received. Unpaced runs
+// measure saturation, so their latency is dominated by queueing in the socket.
+
+namespace {
+
+void sweep(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"bytes", "pps"});
+    for (int64_t bytes : {64, 512, 4096}) {
+        for (int64_t rate : {0, 20000}) {
+            b->Args({bytes, rate});
+        }
+    }
+    b->UseRealTime();
+}
+} // namespace
+
+template <typename Transport>
+static void BM_udp_loopback(benchmark::State& state) {
+    const size_t packetSize = state.range(0);
+    const int64_t intervalNs = state.range(1) ? 1000000000 / state.range(1) : 0;
+
+    std::unique_ptr<typename Transport::Receiver> receiver;
+    std::unique_ptr<typename Transport::Sender> sender;
+    try {
+        receiver.reset(new typename Transport::Receiver());
+        if (receiver->isOk()) {
+            sender.reset(new typename Transport::Sender(receiver->port(), packetSize));
+        }
+    } catch (const std::exception& e) {
+        state.SkipWithError(e.what());
+        return;
+    }
+    if (!receiver->isOk() || !sender->isOk()) {
+        state.SkipWithError("socket setup failed!");
+        return;
+    }
+
+    taposc::ReceiveLog log;
+    std::atomic<bool> finished{false};
+    std::thread receiveThread([&] {
+        const uint64_t allocations = taposc::heapStats().allocations;
+        receiver->run(log);
+        log.allocations = taposc::heapStats().allocations - allocations;
+        finished = true;
+    });
+
+    int32_t sent = 0;
+    int64_t nextNs = taposc::monotonicNs();
+    for (auto _ : state) {
+        if (intervalNs) {
+            while (taposc::monotonicNs() < nextNs) {
+            }
+            nextNs += intervalNs;
+        }
+        sender->send(sent++, taposc::monotonicNs());
+    }
+    sender->flush();
+
+    // Wait for the receiver to drain its socket, then stop it with negative sequence numbers, repeated in case one
+    // is dropped.
+    for (int64_t seen = -1; log.packets.load() < sent && log.packets.load() != seen;) {
+        seen = log.packets.load();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    while (!finished) {
+        sender->send(-1, 0);
+        sender->flush();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    receiveThread.join();
+
+    const int64_t received = log.packets.load();
+    state.SetBytesProcessed(received * packetSize);
+    state.counters["sent_pps"] = benchmark::Counter(sent, benchmark::Counter::kIsRate);
+    state.counters["recv_pps"] = benchmark::Counter(received, benchmark::Counter::kIsRate);
+    state.counters["drop_rate"] = sent ? static_cast<double>(sent - received) / sent : 0.0;
+    state.counters["malformed"] = log.malformed;
+    state.counters["allocs/packet"] = received ? static_cast<double>(log.allocations) / received : 0.0;
+    state.counters["p50_us"] = log.latenciesNs.percentile(50.0) / 1000.0;
+    state.counters["p99_us"] = log.latenciesNs.percentile(99.0) / 1000.0;
+    state.counters["p99.9_us"] = log.latenciesNs.percentile(99.9) / 1000.0;
+}
+
+BENCHMARK_TEMPLATE(BM_udp_loopback, LibloUdp)->Apply(sweep);
+BENCHMARK_TEMPLATE(BM_udp_loopback, OscpackUdp)->Apply(sweep);
+BENCHMARK_TEMPLATE(BM_udp_loopback, OscpackEpollUdp)->Apply(sweep);
+BENCHMARK_TEMPLATE(BM_udp_loopback, OscpktUdp)->Apply(sweep);
+BENCHMARK_TEMPLATE(BM_udp_loopback, OscpktRingUdp)->Apply(sweep);
+BENCHMARK_TEMPLATE(BM_udp_loopback, OscpackBatchUdp)->Apply(sweep);
+BENCHMARK_TEMPLATE(BM_udp_loopback, OscpktBatchUdp)->Apply(sweep);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,92 @@
+#include "bench.h"
+
+#include "osc/OscOutboundPacketStream.h"
+#include "osc/OscReceivedElements.h"
+
+#include <string>
+#include <vector>
+
+// Constructing osc::ReceivedMessage, which validates the whole message up front: the address and type tag strings are
+// searched for their terminators and every argument is checked against the end of the message. These are the shapes
+// where that dominates: long addresses, long runs of fixed size arguments and many string arguments. Building oscpack
+// with OSC_NO_SIMD defined gives the scalar baseline.
+
+namespace {
+
+template <typename Build>
+std::vector<char> makeMessage(size_t capacity, Build build) {
+    std::vector<char> buffer(capacity);
+    osc::OutboundPacketStream p(buffer.data(), buffer.size());
+    build(p);
+    buffer.resize(p.Size());
+    return buffer;
+}
+
+void validate(benchmark::State& state, const std::vector<char>& packet) {
+    HeapMeter heap;
+    for (auto _ : state) {
+        osc::ReceivedMessage message(osc::ReceivedPacket(packet.data(), packet.size()));
+        benchmark::DoNotOptimize(message.ArgumentCount());
+    }
+    heap.report(state);
+    setThroughput(state, packet.size(), 1);
+}
+
+} // namespace
+
+static void BM_oscpack_validate_long_address(benchmark::State& state) {
+    const size_t length = state.range(0);
+    std::string address = "/";
+    while (address.size() < length) {
+        address += "level/";
+    }
+    address.resize(length);
+    validate(state, makeMessage(length + 64, [&](osc::OutboundPacketStream& p) {
+        p << osc::BeginMessage(address.c_str()) << 1.0f << osc::EndMessage;
+    }));
+}
+
+// Repeats i f h d T, so every type tag vector mixes 4 byte, 8 byte and zero length arguments.
+static void BM_oscpack_validate_many_arguments(benchmark::State& state) {
+    const size_t count = state.range(0);
+    validate(state, makeMessage(64 + 10 * count, [&](osc::OutboundPacketStream& p) {
+        p << osc::BeginMessage("/mixer/meters");
+        for (size_t i = 0; i < count; ++i) {
+            switch (i % 5) {
+            case 0:
+                p << static_cast<osc::int32>(i);
+                break;
+            case 1:
+                p << static_cast<float>(i);
+                break;
+            case 2:
+                p << static_cast<osc::int64>(i);
+                break;
+            case 3:
+                p << static_cast<double>(i);
+                break;
+            case 4:
+                p << true;
+                break;
+            }
+        }
+        p << osc::EndMessage;
+    }));
+}
+
+static void BM_oscpack_validate_strings(benchmark::State& state) {
+    const size_t count = state.range(0);
+    const std::string value(state.range(1), 'x');
+    validate(state, makeMessage(64 + count * (value.size() + 5), [&](osc::OutboundPacketStream& p) {
+        p << osc::BeginMessage("/scene/labels");
+        for (size_t i = 0; i < count; ++i) {
+            p << value.c_str();
+        }
+        p << osc::EndMessage;
+    }));
+}
+
+BENCHMARK(BM_oscpack_validate_long_address)->ArgName("length")->Arg(16)->Arg(64)->Arg(256)->Arg(1024);
+BENCHMARK(BM_oscpack_validate_many_arguments)->ArgName("args")->Arg(16)->Arg(256)->Arg(4096);
+BENCHMARK(BM_oscpack_validate_strings)->ArgNames({"args", "length"})->Args({16, 8})->Args({16, 64})->Args({256, 8})
+        ->Args({256, 64});
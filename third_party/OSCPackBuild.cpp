@@ -3,9 +3,11 @@
 #include "oscpack_1_1_0/ip/IpEndpointName.cpp"
 #include "oscpack_1_1_0/ip/posix/NetworkingUtils.cpp"
 #include "oscpack_1_1_0/ip/posix/UdpSocket.cpp"
+#include "oscpack_1_1_0/ip/posix/UdpReceiverPool.cpp"
 
 #include "oscpack_1_1_0/osc/OscOutboundPacketStream.cpp"
 #include "oscpack_1_1_0/osc/OscPrintReceivedElements.cpp"
 #include "oscpack_1_1_0/osc/OscReceivedElements.cpp"
 #include "oscpack_1_1_0/osc/OscTypes.cpp"
+#include "oscpack_1_1_0/osc/ScheduledOscPacketListener.cpp"
 
@@ -0,0 +1,90 @@
+/*
+	oscpack -- Open Sound Control (OSC) packet manipulation library
+    http://www.rossbencina.com/code/oscpack
+
+    Copyright (c) 2004-2013 Ross Bencina <rossb@audiomulch.com>
+
+	Permission is hereby granted, free of charge, to any person obtaining
+	a copy of this software and associated documentation files
+	(the "Software"), to deal in the Software without restriction,
+	including without limitation the rights to use, copy, modify, merge,
+	publish, distribute, sublicense, and/or sell copies of the Software,
+	and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+	MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+	IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+	ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+	WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+/*
+	The text above constitutes the entire oscpack license; however, 
+	the oscpack developer(s) also make the following non-binding requests:
+
+	Any person wishing to distribute modifications to the Software is
+	requested to send the modifications to the original developer so that
+	they can be incorporated into the canonical version. It is also 
+	requested that these non-binding requests be included whenever the
+	above license is reproduced.
+*/
+#ifndef INCLUDED_OSCPACK_UDPRECEIVERPOOL_H
+#define INCLUDED_OSCPACK_UDPRECEIVERPOOL_H
+
+#include <cstring> // size_t
+
+#include "UdpSocket.h"
+
+
+class PacketListener;
+
+
+// Receives datagrams sent to one endpoint on several threads. Each shard
+// is a UdpSocket bound to the endpoint with SO_REUSEPORT, a
+// SocketReceiveMultiplexer and a PacketListener, and runs on a thread of
+// its own. The kernel assigns each sender (address and port) to one of the
+// sockets, so packets from one sender always reach the same listener, in
+// order, while different senders are spread across the shards.
+//
+// Requires SO_REUSEPORT with load balancing, i.e. Linux 3.9 or later.
+
+class UdpReceiverPool{
+    class Implementation;
+    Implementation *impl_;
+
+    UdpReceiverPool( const UdpReceiverPool& ); // no copying
+    UdpReceiverPool& operator=( const UdpReceiverPool& );
+
+public:
+    // Creates one shard per listener, listeners[i] receiving the packets of
+    // shard i. Throws std::runtime_error if a socket cannot be created or
+    // bound.
+    UdpReceiverPool( const IpEndpointName& localEndpoint, PacketListener **listeners, std::size_t count );
+    ~UdpReceiverPool(); // stops the threads if they are running
+
+    std::size_t ShardCount() const;
+
+    // The multiplexer of shard i, for attaching timers or raising the
+    // maximum datagram size. Only configure it before Start().
+    SocketReceiveMultiplexer& Multiplexer( std::size_t index );
+
+    // Runs each shard's multiplexer on its own thread. With pinThreads set
+    // thread i is bound to the i'th CPU the process is allowed to run on,
+    // wrapping around when there are more shards than CPUs. Pinning is
+    // only supported on Linux and ignored elsewhere.
+    void Start( bool pinThreads=true );
+
+    // Breaks every multiplexer out of Run() and waits for the threads to
+    // finish. Throws std::runtime_error if a multiplexer stopped with an
+    // exception.
+    void Stop();
+};
+
+
+#endif /* INCLUDED_OSCPACK_UDPRECEIVERPOOL_H */
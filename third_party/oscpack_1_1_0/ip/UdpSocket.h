@@ -48,6 +48,18 @@ class TimerListener;
 
 class UdpSocket;
 
+
+// A packet slot for the batched UdpSocket calls. The caller owns the
+// buffer. ReceiveBatch() fills in size and remoteEndpoint, SendBatch()
+// sends the first size bytes of data.
+struct UdpDatagram{
+    char *data;
+    std::size_t capacity;
+    std::size_t size;
+    IpEndpointName remoteEndpoint;
+};
+
+
 class SocketReceiveMultiplexer{
     class Implementation;
     Implementation *impl_;
@@ -55,7 +67,15 @@ class SocketReceiveMultiplexer{
 	friend class UdpSocket;
 
 public:
-    SocketReceiveMultiplexer();
+    // How Run() waits for incoming packets. SELECT_NOTIFICATION is limited
+    // to descriptors below FD_SETSIZE and scans every attached socket on each
+    // wakeup. EPOLL_NOTIFICATION has no descriptor limit and only visits
+    // sockets that are ready; it is available on Linux, elsewhere it behaves
+    // like SELECT_NOTIFICATION.
+    enum NotificationMode { SELECT_NOTIFICATION, EPOLL_NOTIFICATION };
+
+    SocketReceiveMultiplexer(); // uses SELECT_NOTIFICATION
+    explicit SocketReceiveMultiplexer( NotificationMode mode );
     ~SocketReceiveMultiplexer();
 
 	// only call the attach/detach methods _before_ calling Run
@@ -69,6 +89,24 @@ public:
             int initialDelayMilliseconds, int periodMilliseconds, TimerListener *listener );
     void DetachPeriodicTimerListener( TimerListener *listener );  
 
+    // The largest datagram Run() can receive. Longer datagrams are
+    // truncated to this size. Defaults to 4098 bytes; throws
+    // std::runtime_error for zero or more than MAX_DATAGRAM_SIZE, and
+    // while Run() is running or packet buffers are still retained.
+    enum { DEFAULT_DATAGRAM_SIZE = 4098, MAX_DATAGRAM_SIZE = 65536 };
+    void SetMaximumDatagramSize( std::size_t size );
+    std::size_t MaximumDatagramSize() const;
+
+    // Packets are received into buffers from a pool owned by the
+    // multiplexer. Calling RetainPacketBuffer() from inside
+    // PacketListener::ProcessPacket() takes ownership of the buffer holding
+    // the packet being processed, so it stays valid after ProcessPacket()
+    // returns, and returns the data pointer that was passed to
+    // ProcessPacket(). Hand it back with ReleasePacketBuffer(), which may be
+    // called from any thread, before the multiplexer is destroyed.
+    char *RetainPacketBuffer();
+    void ReleasePacketBuffer( char *data );
+
     void Run();      // loop and block processing messages indefinitely
 	void RunUntilSigInt();
     void Break();    // call this from a listener to exit once the listener returns
@@ -102,6 +140,13 @@ public:
 	// operating systems.
 	void SetAllowReuse( bool allowReuse );
 
+	// Sets SO_REUSEPORT, so that several sockets can bind the same
+	// endpoint. On Linux the incoming datagrams are then spread across
+	// all of them by a hash of each sender's address and port, see
+	// UdpReceiverPool. Call before Bind(). Throws std::runtime_error
+	// where SO_REUSEPORT is not available.
+	void SetReusePort( bool reusePort );
+
 
 	// The socket is created in an unbound, unconnected state
 	// such a socket can only be used to send to an arbitrary
@@ -126,6 +171,20 @@ public:
 	bool IsBound() const;
 
     std::size_t ReceiveFrom( IpEndpointName& remoteEndpoint, char *data, std::size_t size );
+
+
+	// Batched variants of Send() and ReceiveFrom(), which on Linux move
+	// many datagrams per system call with sendmmsg() and recvmmsg().
+	// Elsewhere they fall back to one call per datagram.
+
+	// Blocks until at least one datagram is available, then receives up to
+	// count datagrams without blocking further. Returns the number of slots
+	// filled, 0 on error.
+	std::size_t ReceiveBatch( UdpDatagram *datagrams, std::size_t count );
+
+	// Sends count datagrams to the connected endpoint. Returns the number
+	// of datagrams sent.
+	std::size_t SendBatch( const UdpDatagram *datagrams, std::size_t count );
 };
 
 
@@ -0,0 +1,283 @@
+/*
+	oscpack -- Open Sound Control (OSC) packet manipulation library
+    http://www.rossbencina.com/code/oscpack
+
+    Copyright (c) 2004-2013 Ross Bencina <rossb@audiomulch.com>
+
+	Permission is hereby granted, free of charge, to any person obtaining
+	a copy of this software and associated documentation files
+	(the "Software"), to deal in the Software without restriction,
+	including without limitation the rights to use, copy, modify, merge,
+	publish, distribute, sublicense, and/or sell copies of the Software,
+	and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+	MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+	IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+	ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+	WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+/*
+	The text above constitutes the entire oscpack license; however, 
+	the oscpack developer(s) also make the following non-binding requests:
+
+	Any person wishing to distribute modifications to the Software is
+	requested to send the modifications to the original developer so that
+	they can be incorporated into the canonical version. It is also 
+	requested that these non-binding requests be included whenever the
+	above license is reproduced.
+*/
+#include "ip/UdpReceiverPool.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ip/PacketListener.h"
+
+
+struct UdpReceiverPoolShard{
+	// each shard serves a single busy socket, which epoll drains several
+	// datagrams at a time
+	UdpReceiverPoolShard()
+		: multiplexer( SocketReceiveMultiplexer::EPOLL_NOTIFICATION ) {}
+
+	UdpSocket socket;
+	SocketReceiveMultiplexer multiplexer;
+	PacketListener *listener;
+
+	pthread_t thread;
+	bool running;
+
+	// written by the shard's thread, read by Stop() under mutex
+	pthread_mutex_t *mutex;
+	bool finished;
+	bool failed;
+	std::string error;
+};
+
+
+extern "C" /*static*/ void *RunUdpReceiverPoolShard( void *arg );
+/*static*/ void *RunUdpReceiverPoolShard( void *arg )
+{
+	UdpReceiverPoolShard *shard = (UdpReceiverPoolShard*)arg;
+
+	bool failed = false;
+	std::string error;
+	try{
+		shard->multiplexer.Run();
+	}catch( std::exception& e ){
+		failed = true;
+		error = e.what();
+	}catch(...){
+		failed = true;
+		error = "unknown exception in receiver pool thread\n";
+	}
+
+	pthread_mutex_lock( shard->mutex );
+	shard->finished = true;
+	shard->failed = failed;
+	shard->error = error;
+	pthread_mutex_unlock( shard->mutex );
+
+	return 0;
+}
+
+
+class UdpReceiverPool::Implementation{
+	std::vector< UdpReceiverPoolShard* > shards_;
+	pthread_mutex_t mutex_;
+
+	void DeleteShards()
+	{
+		for( std::vector< UdpReceiverPoolShard* >::iterator i = shards_.begin(); i != shards_.end(); ++i )
+			delete *i;
+		shards_.clear();
+	}
+
+	bool IsFinished( UdpReceiverPoolShard *shard )
+	{
+		pthread_mutex_lock( &mutex_ );
+		bool finished = shard->finished;
+		pthread_mutex_unlock( &mutex_ );
+		return finished;
+	}
+
+	// the CPUs this process may run on, empty if they can't be determined
+	static std::vector< int > AllowedCpus()
+	{
+		std::vector< int > cpus;
+#if defined(__linux__)
+		cpu_set_t set;
+		CPU_ZERO( &set );
+		if( sched_getaffinity( 0, sizeof(set), &set ) == 0 ){
+			for( int cpu = 0; cpu < CPU_SETSIZE; ++cpu ){
+				if( CPU_ISSET( cpu, &set ) )
+					cpus.push_back( cpu );
+			}
+		}
+#endif
+		return cpus;
+	}
+
+public:
+	Implementation( const IpEndpointName& localEndpoint, PacketListener **listeners, std::size_t count )
+	{
+		pthread_mutex_init( &mutex_, 0 );
+
+		try{
+			for( std::size_t i = 0; i < count; ++i ){
+				UdpReceiverPoolShard *shard = new UdpReceiverPoolShard;
+				shards_.push_back( shard );
+
+				shard->listener = listeners[i];
+				shard->running = false;
+				shard->mutex = &mutex_;
+				shard->finished = false;
+				shard->failed = false;
+
+				shard->socket.SetReusePort( true );
+				shard->socket.Bind( localEndpoint );
+				shard->multiplexer.AttachSocketListener( &shard->socket, shard->listener );
+			}
+		}catch(...){
+			DeleteShards();
+			pthread_mutex_destroy( &mutex_ );
+			throw;
+		}
+	}
+
+	~Implementation()
+	{
+		try{
+			Stop();
+		}catch(...){
+		}
+		DeleteShards();
+		pthread_mutex_destroy( &mutex_ );
+	}
+
+	std::size_t ShardCount() const
+	{
+		return shards_.size();
+	}
+
+	SocketReceiveMultiplexer& Multiplexer( std::size_t index )
+	{
+		assert( index < shards_.size() );
+		return shards_[index]->multiplexer;
+	}
+
+	void Start( bool pinThreads )
+	{
+		std::vector< int > cpus;
+		if( pinThreads )
+			cpus = AllowedCpus();
+
+		for( std::size_t i = 0; i < shards_.size(); ++i ){
+			UdpReceiverPoolShard *shard = shards_[i];
+			assert( !shard->running );
+
+			shard->finished = false;
+			shard->failed = false;
+			shard->error.clear();
+
+			pthread_attr_t attr;
+			pthread_attr_init( &attr );
+#if defined(__linux__)
+			// pin before the thread starts, so it never runs anywhere else
+			if( !cpus.empty() ){
+				cpu_set_t set;
+				CPU_ZERO( &set );
+				CPU_SET( cpus[ i % cpus.size() ], &set );
+				pthread_attr_setaffinity_np( &attr, sizeof(set), &set );
+			}
+#endif
+			int result = pthread_create( &shard->thread, &attr, RunUdpReceiverPoolShard, shard );
+			pthread_attr_destroy( &attr );
+
+			if( result != 0 ){
+				Stop();
+				throw std::runtime_error( "unable to create receiver pool thread\n" );
+			}
+			shard->running = true;
+		}
+	}
+
+	void Stop()
+	{
+		std::string error;
+
+		for( std::vector< UdpReceiverPoolShard* >::iterator i = shards_.begin(); i != shards_.end(); ++i ){
+			UdpReceiverPoolShard *shard = *i;
+			if( !shard->running )
+				continue;
+
+			// Run() clears the break flag on entry, so a break that lands
+			// before the thread gets there is lost. keep breaking until the
+			// thread reports that Run() has returned. the break pipe is
+			// non-blocking and drained when Run() starts, so the extra
+			// messages neither block here nor carry over into the next run.
+			for(;;){
+				shard->multiplexer.AsynchronousBreak();
+				if( IsFinished( shard ) )
+					break;
+
+				struct timespec pause = { 0, 1000000 }; // 1ms
+				nanosleep( &pause, 0 );
+			}
+
+			pthread_join( shard->thread, 0 );
+			shard->running = false;
+
+			if( shard->failed && error.empty() )
+				error = shard->error;
+		}
+
+		if( !error.empty() )
+			throw std::runtime_error( error );
+	}
+};
+
+
+UdpReceiverPool::UdpReceiverPool( const IpEndpointName& localEndpoint, PacketListener **listeners, std::size_t count )
+{
+	impl_ = new Implementation( localEndpoint, listeners, count );
+}
+
+UdpReceiverPool::~UdpReceiverPool()
+{
+	delete impl_;
+}
+
+std::size_t UdpReceiverPool::ShardCount() const
+{
+	return impl_->ShardCount();
+}
+
+SocketReceiveMultiplexer& UdpReceiverPool::Multiplexer( std::size_t index )
+{
+	return impl_->Multiplexer( index );
+}
+
+void UdpReceiverPool::Start( bool pinThreads )
+{
+	impl_->Start( pinThreads );
+}
+
+void UdpReceiverPool::Stop()
+{
+	impl_->Stop();
+}
@@ -44,15 +44,25 @@
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <sys/time.h>
+#include <time.h> // clock_gettime
+#include <stdint.h>
 #include <netinet/in.h> // for sockaddr_in
 
+#if defined(__linux__)
+#define OSC_HAVE_EPOLL
+#define OSC_HAVE_MMSG
+#include <sys/epoll.h>
+#endif
+
 #include <signal.h>
 #include <math.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <string.h> 
 
 #include <algorithm>
 #include <cassert>
+#include <climits> // INT_MAX
 #include <cstring> // for memset
 #include <stdexcept>
 #include <vector>
@@ -143,6 +153,18 @@ public:
 #endif
 	}
 
+	void SetReusePort( bool reusePort )
+	{
+#ifdef SO_REUSEPORT
+		int value = (reusePort) ? 1 : 0; // int on posix
+		if( setsockopt(socket_, SOL_SOCKET, SO_REUSEPORT, &value, sizeof(value)) != 0 )
+			throw std::runtime_error("unable to set SO_REUSEPORT\n");
+#else
+		(void) reusePort;
+		throw std::runtime_error("SO_REUSEPORT is not supported\n");
+#endif
+	}
+
 	IpEndpointName LocalEndpointFor( const IpEndpointName& remoteEndpoint ) const
 	{
 		assert( isBound_ );
@@ -246,6 +268,126 @@ public:
 		return (std::size_t)result;
 	}
 
+	// non-blocking variant of ReceiveFrom() used by the epoll multiplexer.
+	// returns false once no datagram is waiting. other errors, such as a
+	// pending ECONNREFUSED on a connected socket, are reported as an empty
+	// datagram so that the caller keeps reading.
+	bool TryReceiveFrom( IpEndpointName& remoteEndpoint, char *data, std::size_t size, std::size_t& received )
+	{
+		assert( isBound_ );
+
+		struct sockaddr_in fromAddr;
+        socklen_t fromAddrLen = sizeof(fromAddr);
+
+        ssize_t result = recvfrom(socket_, data, size, MSG_DONTWAIT,
+                    (struct sockaddr *) &fromAddr, (socklen_t*)&fromAddrLen);
+		if( result < 0 ){
+			if( errno == EAGAIN || errno == EWOULDBLOCK )
+				return false;
+			received = 0;
+			return true;
+		}
+
+		remoteEndpoint.address = ntohl(fromAddr.sin_addr.s_addr);
+		remoteEndpoint.port = ntohs(fromAddr.sin_port);
+
+		received = (std::size_t)result;
+		return true;
+	}
+
+#ifdef OSC_HAVE_MMSG
+
+	// the most datagrams moved by one recvmmsg() or sendmmsg() call
+	enum { MAX_BATCH_SIZE = 64 };
+
+    std::size_t ReceiveBatch( UdpDatagram *datagrams, std::size_t count )
+	{
+		assert( isBound_ );
+
+		if( count > MAX_BATCH_SIZE )
+			count = MAX_BATCH_SIZE;
+
+		struct mmsghdr messages[ MAX_BATCH_SIZE ];
+		struct iovec buffers[ MAX_BATCH_SIZE ];
+		struct sockaddr_in fromAddrs[ MAX_BATCH_SIZE ];
+		std::memset( messages, 0, sizeof(messages[0]) * count );
+
+		for( std::size_t i = 0; i < count; ++i ){
+			buffers[i].iov_base = datagrams[i].data;
+			buffers[i].iov_len = datagrams[i].capacity;
+			messages[i].msg_hdr.msg_iov = &buffers[i];
+			messages[i].msg_hdr.msg_iovlen = 1;
+			messages[i].msg_hdr.msg_name = &fromAddrs[i];
+			messages[i].msg_hdr.msg_namelen = sizeof(fromAddrs[i]);
+		}
+
+		// MSG_WAITFORONE blocks for the first datagram only
+		int result = recvmmsg( socket_, messages, (unsigned int)count, MSG_WAITFORONE, 0 );
+		if( result < 0 )
+			return 0;
+
+		for( int i = 0; i < result; ++i ){
+			datagrams[i].size = messages[i].msg_len;
+			datagrams[i].remoteEndpoint.address = ntohl(fromAddrs[i].sin_addr.s_addr);
+			datagrams[i].remoteEndpoint.port = ntohs(fromAddrs[i].sin_port);
+		}
+
+		return (std::size_t)result;
+	}
+
+	std::size_t SendBatch( const UdpDatagram *datagrams, std::size_t count )
+	{
+		assert( isConnected_ );
+
+		struct mmsghdr messages[ MAX_BATCH_SIZE ];
+		struct iovec buffers[ MAX_BATCH_SIZE ];
+
+		std::size_t sent = 0;
+		while( sent < count ){
+			std::size_t batchSize = count - sent;
+			if( batchSize > MAX_BATCH_SIZE )
+				batchSize = MAX_BATCH_SIZE;
+
+			std::memset( messages, 0, sizeof(messages[0]) * batchSize );
+			for( std::size_t i = 0; i < batchSize; ++i ){
+				buffers[i].iov_base = datagrams[sent + i].data;
+				buffers[i].iov_len = datagrams[sent + i].size;
+				messages[i].msg_hdr.msg_iov = &buffers[i];
+				messages[i].msg_hdr.msg_iovlen = 1;
+			}
+
+			int result = sendmmsg( socket_, messages, (unsigned int)batchSize, 0 );
+			if( result < 0 ){
+				if( errno == EINTR )
+					continue;
+				break;
+			}
+			sent += result;
+		}
+
+		return sent;
+	}
+
+#else /* OSC_HAVE_MMSG */
+
+    std::size_t ReceiveBatch( UdpDatagram *datagrams, std::size_t count )
+	{
+		if( count == 0 )
+			return 0;
+
+		datagrams[0].size = ReceiveFrom( datagrams[0].remoteEndpoint, datagrams[0].data, datagrams[0].capacity );
+		return (datagrams[0].size > 0) ? 1 : 0;
+	}
+
+	std::size_t SendBatch( const UdpDatagram *datagrams, std::size_t count )
+	{
+		for( std::size_t i = 0; i < count; ++i )
+			Send( datagrams[i].data, datagrams[i].size );
+		return count;
+	}
+
+#endif /* OSC_HAVE_MMSG */
+
 	int Socket() { return socket_; }
 };
 
@@ -269,6 +411,11 @@ void UdpSocket::SetAllowReuse( bool allowReuse )
     impl_->SetAllowReuse( allowReuse );
 }
 
+void UdpSocket::SetReusePort( bool reusePort )
+{
+    impl_->SetReusePort( reusePort );
+}
+
 IpEndpointName UdpSocket::LocalEndpointFor( const IpEndpointName& remoteEndpoint ) const
 {
 	return impl_->LocalEndpointFor( remoteEndpoint );
@@ -304,6 +451,16 @@ std::size_t UdpSocket::ReceiveFrom( IpEndpointName& remoteEndpoint, char *data,
 	return impl_->ReceiveFrom( remoteEndpoint, data, size );
 }
 
+std::size_t UdpSocket::ReceiveBatch( UdpDatagram *datagrams, std::size_t count )
+{
+	return impl_->ReceiveBatch( datagrams, count );
+}
+
+std::size_t UdpSocket::SendBatch( const UdpDatagram *datagrams, std::size_t count )
+{
+	return impl_->SendBatch( datagrams, count );
+}
+
 
 struct AttachedTimerListener{
 	AttachedTimerListener( int id, int p, TimerListener *tl )
@@ -316,10 +473,11 @@ struct AttachedTimerListener{
 };
 
 
-static bool CompareScheduledTimerCalls( 
-		const std::pair< double, AttachedTimerListener > & lhs, const std::pair< double, AttachedTimerListener > & rhs )
+// orders the timer queue as a min-heap on expiry time
+static bool ScheduledTimerCallIsLater( 
+		const std::pair< uint64_t, AttachedTimerListener > & lhs, const std::pair< uint64_t, AttachedTimerListener > & rhs )
 {
-	return lhs.first < rhs.first;
+	return lhs.first > rhs.first;
 }
 
 
@@ -333,78 +491,188 @@ extern "C" /*static*/ void InterruptSignalHandler( int );
 }
 
 
-class SocketReceiveMultiplexer::Implementation{
-	std::vector< std::pair< PacketListener*, UdpSocket* > > socketListeners_;
-	std::vector< AttachedTimerListener > timerListeners_;
+// receive buffers of a single size, recycled across packets and calls to
+// Run(). Release() may be called from any thread.
+class PacketBufferPool{
+	std::vector< char* > free_;
+	std::size_t bufferSize_;
+	std::size_t outstandingCount_;
+	pthread_mutex_t mutex_;
 
-	volatile bool break_;
-	int breakPipe_[2]; // [0] is the reader descriptor and [1] the writer
+	void DeleteFreeBuffers()
+	{
+		for( std::vector< char* >::iterator i = free_.begin(); i != free_.end(); ++i )
+			delete [] *i;
+		free_.clear();
+	}
+
+public:
+	PacketBufferPool( std::size_t bufferSize )
+		: bufferSize_( bufferSize )
+		, outstandingCount_( 0 )
+	{
+		pthread_mutex_init( &mutex_, 0 );
+	}
 
-	double GetCurrentTimeMs() const
+	~PacketBufferPool()
 	{
-		struct timeval t;
+		assert( outstandingCount_ == 0 );
+		DeleteFreeBuffers();
+		pthread_mutex_destroy( &mutex_ );
+	}
 
-		gettimeofday( &t, 0 );
+	std::size_t BufferSize() const { return bufferSize_; }
 
-		return ((double)t.tv_sec*1000.) + ((double)t.tv_usec / 1000.);
+	// buffers handed out at the old size would otherwise come back into
+	// the pool and be received into at the new one
+	void SetBufferSize( std::size_t bufferSize )
+	{
+		pthread_mutex_lock( &mutex_ );
+		if( outstandingCount_ != 0 ){
+			pthread_mutex_unlock( &mutex_ );
+			throw std::runtime_error( "cannot change the datagram size while packet buffers are in use\n" );
+		}
+		DeleteFreeBuffers();
+		bufferSize_ = bufferSize;
+		pthread_mutex_unlock( &mutex_ );
 	}
 
-public:
-    Implementation()
+	char *Acquire()
 	{
-		if( pipe(breakPipe_) != 0 )
-			throw std::runtime_error( "creation of asynchronous break pipes failed\n" );
+		char *buffer = 0;
+		pthread_mutex_lock( &mutex_ );
+		if( !free_.empty() ){
+			buffer = free_.back();
+			free_.pop_back();
+		}
+		++outstandingCount_;
+		pthread_mutex_unlock( &mutex_ );
+
+		if( !buffer ){
+			try{
+				buffer = new char[ bufferSize_ ];
+			}catch(...){
+				pthread_mutex_lock( &mutex_ );
+				--outstandingCount_;
+				pthread_mutex_unlock( &mutex_ );
+				throw;
+			}
+		}
+		return buffer;
 	}
 
-    ~Implementation()
+	void Release( char *buffer )
 	{
-		close( breakPipe_[0] );
-		close( breakPipe_[1] );
+		pthread_mutex_lock( &mutex_ );
+		try{
+			free_.push_back( buffer );
+		}catch(...){
+			delete [] buffer;
+		}
+		--outstandingCount_;
+		pthread_mutex_unlock( &mutex_ );
 	}
+};
 
-    void AttachSocketListener( UdpSocket *socket, PacketListener *listener )
+
+class SocketReceiveMultiplexer::Implementation{
+	std::vector< std::pair< PacketListener*, UdpSocket* > > socketListeners_;
+	std::vector< AttachedTimerListener > timerListeners_;
+
+	NotificationMode mode_;
+	volatile bool break_;
+	int breakPipe_[2]; // [0] is the reader descriptor and [1] the writer
+
+	PacketBufferPool packetBuffers_;
+	char *currentPacket_; // the buffer passed to ProcessPacket(), zero outside it
+	bool currentPacketRetained_;
+
+	// expiry time in monotonic nanoseconds, listener. kept as a min-heap
+	// ordered by ScheduledTimerCallIsLater, so the next timer due is front()
+	typedef std::vector< std::pair< uint64_t, AttachedTimerListener > > TimerQueue;
+
+	static uint64_t MillisecondsToNs( int ms )
 	{
-		assert( std::find( socketListeners_.begin(), socketListeners_.end(), std::make_pair(listener, socket) ) == socketListeners_.end() );
-		// we don't check that the same socket has been added multiple times, even though this is an error
-		socketListeners_.push_back( std::make_pair( listener, socket ) );
+		return (uint64_t)ms * 1000000;
 	}
 
-    void DetachSocketListener( UdpSocket *socket, PacketListener *listener )
+	uint64_t GetCurrentTimeNs() const
 	{
-		std::vector< std::pair< PacketListener*, UdpSocket* > >::iterator i = 
-				std::find( socketListeners_.begin(), socketListeners_.end(), std::make_pair(listener, socket) );
-		assert( i != socketListeners_.end() );
+		struct timespec t;
 
-		socketListeners_.erase( i );
+		clock_gettime( CLOCK_MONOTONIC, &t );
+
+		return (uint64_t)t.tv_sec * 1000000000 + (uint64_t)t.tv_nsec;
 	}
 
-    void AttachPeriodicTimerListener( int periodMilliseconds, TimerListener *listener )
+	void InitializeTimerQueue( TimerQueue& timerQueue ) const
 	{
-		timerListeners_.push_back( AttachedTimerListener( periodMilliseconds, periodMilliseconds, listener ) );
+		uint64_t currentTimeNs = GetCurrentTimeNs();
+
+		for( std::vector< AttachedTimerListener >::const_iterator i = timerListeners_.begin();
+				i != timerListeners_.end(); ++i )
+			timerQueue.push_back( std::make_pair( currentTimeNs + MillisecondsToNs( i->initialDelayMs ), *i ) );
+		std::make_heap( timerQueue.begin(), timerQueue.end(), ScheduledTimerCallIsLater );
 	}
 
-	void AttachPeriodicTimerListener( int initialDelayMilliseconds, int periodMilliseconds, TimerListener *listener )
+	// nanoseconds until the earliest timer is due, zero if it is overdue.
+	// the queue must not be empty.
+	uint64_t TimeUntilNextTimerNs( const TimerQueue& timerQueue ) const
 	{
-		timerListeners_.push_back( AttachedTimerListener( initialDelayMilliseconds, periodMilliseconds, listener ) );
+		uint64_t currentTimeNs = GetCurrentTimeNs();
+		uint64_t dueNs = timerQueue.front().first;
+		return (dueNs > currentTimeNs) ? dueNs - currentTimeNs : 0;
 	}
 
-    void DetachPeriodicTimerListener( TimerListener *listener )
+	// calls every timer that was due on entry, at most once each, in expiry
+	// order. each is popped off the heap into the tail of the vector and
+	// rescheduled there, then pushed back once the pass is over, so a timer
+	// whose next expiry has also passed waits for the next call instead of
+	// being run again now. costs O(log n) per expired timer.
+	void ExecuteExpiredTimers( TimerQueue& timerQueue )
 	{
-		std::vector< AttachedTimerListener >::iterator i = timerListeners_.begin();
-		while( i != timerListeners_.end() ){
-			if( i->listener == listener )
+		uint64_t currentTimeNs = GetCurrentTimeNs();
+		TimerQueue::iterator heapEnd = timerQueue.end();
+		while( heapEnd != timerQueue.begin() && timerQueue.front().first <= currentTimeNs ){
+			std::pop_heap( timerQueue.begin(), heapEnd, ScheduledTimerCallIsLater );
+			--heapEnd;
+
+			heapEnd->second.listener->TimerExpired();
+			heapEnd->first += MillisecondsToNs( heapEnd->second.periodMs );
+			if( break_ )
 				break;
-			++i;
 		}
 
-		assert( i != timerListeners_.end() );
+		while( heapEnd != timerQueue.end() ){
+			++heapEnd;
+			std::push_heap( timerQueue.begin(), heapEnd, ScheduledTimerCallIsLater );
+		}
+	}
 
-		timerListeners_.erase( i );
+	// passes the packet in data to listener. if the listener retains the
+	// buffer, data is replaced with a fresh one from the pool.
+	void DispatchPacket( PacketListener *listener, char *&data, std::size_t size, const IpEndpointName& remoteEndpoint )
+	{
+		currentPacket_ = data;
+		currentPacketRetained_ = false;
+		try{
+			listener->ProcessPacket( data, (int)size, remoteEndpoint );
+		}catch(...){
+			if( currentPacketRetained_ )
+				data = 0;
+			currentPacket_ = 0;
+			throw;
+		}
+		currentPacket_ = 0;
+
+		if( currentPacketRetained_ ){
+			data = 0;
+			data = packetBuffers_.Acquire();
+		}
 	}
 
-    void Run()
+	void RunSelect()
 	{
-		break_ = false;
         char *data = 0;
         
         try{
@@ -424,6 +692,10 @@ public:
             for( std::vector< std::pair< PacketListener*, UdpSocket* > >::iterator i = socketListeners_.begin();
                     i != socketListeners_.end(); ++i ){
 
+                // FD_SET() on a larger descriptor writes past the end of the fd_set
+                if( i->second->impl_->Socket() >= FD_SETSIZE )
+                    throw std::runtime_error("socket descriptor exceeds FD_SETSIZE\n");
+
                 if( fdmax < i->second->impl_->Socket() )
                     fdmax = i->second->impl_->Socket();
                 FD_SET( i->second->impl_->Socket(), &masterfds );
@@ -431,17 +703,10 @@ public:
 
 
             // configure the timer queue
-            double currentTimeMs = GetCurrentTimeMs();
-
-            // expiry time ms, listener
-            std::vector< std::pair< double, AttachedTimerListener > > timerQueue_;
-            for( std::vector< AttachedTimerListener >::iterator i = timerListeners_.begin();
-                    i != timerListeners_.end(); ++i )
-                timerQueue_.push_back( std::make_pair( currentTimeMs + i->initialDelayMs, *i ) );
-            std::sort( timerQueue_.begin(), timerQueue_.end(), CompareScheduledTimerCalls );
+            TimerQueue timerQueue_;
+            InitializeTimerQueue( timerQueue_ );
 
-            const int MAX_BUFFER_SIZE = 4098;
-            data = new char[ MAX_BUFFER_SIZE ];
+            data = packetBuffers_.Acquire();
             IpEndpointName remoteEndpoint;
 
             struct timeval timeout;
@@ -451,14 +716,12 @@ public:
 
                 struct timeval *timeoutPtr = 0;
                 if( !timerQueue_.empty() ){
-                    double timeoutMs = timerQueue_.front().first - GetCurrentTimeMs();
-                    if( timeoutMs < 0 )
-                        timeoutMs = 0;
+                    // round up, so that select() doesn't return just before the timer is due
+                    uint64_t timeoutUs = (TimeUntilNextTimerNs( timerQueue_ ) + 999) / 1000;
                 
-                    long timoutSecondsPart = (long)(timeoutMs * .001);
-                    timeout.tv_sec = (time_t)timoutSecondsPart;
                     // 1000000 microseconds in a second
-                    timeout.tv_usec = (suseconds_t)((timeoutMs - (timoutSecondsPart * 1000)) * 1000);
+                    timeout.tv_sec = (time_t)(timeoutUs / 1000000);
+                    timeout.tv_usec = (suseconds_t)(timeoutUs % 1000000);
                     timeoutPtr = &timeout;
                 }
 
@@ -490,9 +753,9 @@ public:
 
                     if( FD_ISSET( i->second->impl_->Socket(), &tempfds ) ){
 
-                        std::size_t size = i->second->ReceiveFrom( remoteEndpoint, data, MAX_BUFFER_SIZE );
+                        std::size_t size = i->second->ReceiveFrom( remoteEndpoint, data, packetBuffers_.BufferSize() );
                         if( size > 0 ){
-                            i->first->ProcessPacket( data, (int)size, remoteEndpoint );
+                            DispatchPacket( i->first, data, size, remoteEndpoint );
                             if( break_ )
                                 break;
                         }
@@ -500,30 +763,249 @@ public:
                 }
 
                 // execute any expired timers
-                currentTimeMs = GetCurrentTimeMs();
-                bool resort = false;
-                for( std::vector< std::pair< double, AttachedTimerListener > >::iterator i = timerQueue_.begin();
-                        i != timerQueue_.end() && i->first <= currentTimeMs; ++i ){
-
-                    i->second.listener->TimerExpired();
-                    if( break_ )
-                        break;
-
-                    i->first += i->second.periodMs;
-                    resort = true;
-                }
-                if( resort )
-                    std::sort( timerQueue_.begin(), timerQueue_.end(), CompareScheduledTimerCalls );
+                ExecuteExpiredTimers( timerQueue_ );
             }
 
-            delete [] data;
+            packetBuffers_.Release( data );
         }catch(...){
             if( data )
-                delete [] data;
+                packetBuffers_.Release( data );
             throw;
         }
 	}
 
+#ifdef OSC_HAVE_EPOLL
+
+	// the most datagrams read from one socket before moving on to the next
+	// ready socket, so that a busy socket cannot starve the others.
+	static const int MAX_DATAGRAMS_PER_WAKEUP = 16;
+
+	void RunEpoll()
+	{
+		int epollFd = epoll_create1( EPOLL_CLOEXEC );
+		if( epollFd == -1 )
+			throw std::runtime_error("epoll_create1 failed\n");
+
+		char *data = 0;
+
+		try{
+
+			// the break pipe is registered level-triggered with a zero key,
+			// sockets edge-triggered with their index in socketListeners_ plus one.
+			// an edge-triggered socket is only reported again once new data
+			// arrives, so every socket that might still hold data stays on the
+			// pending list below until a read returns EAGAIN. sockets left
+			// pending when Run() returns are reported again on the next Run(),
+			// because registering a readable descriptor raises an event.
+
+			struct epoll_event event;
+			std::memset( &event, 0, sizeof(event) );
+			event.events = EPOLLIN;
+			event.data.u64 = 0;
+			if( epoll_ctl( epollFd, EPOLL_CTL_ADD, breakPipe_[0], &event ) != 0 )
+				throw std::runtime_error("epoll_ctl failed\n");
+
+			for( std::size_t i = 0; i < socketListeners_.size(); ++i ){
+				event.events = EPOLLIN | EPOLLET;
+				event.data.u64 = i + 1;
+				if( epoll_ctl( epollFd, EPOLL_CTL_ADD, socketListeners_[i].second->impl_->Socket(), &event ) != 0 )
+					throw std::runtime_error("epoll_ctl failed\n");
+			}
+
+			TimerQueue timerQueue;
+			InitializeTimerQueue( timerQueue );
+
+			data = packetBuffers_.Acquire();
+			IpEndpointName remoteEndpoint;
+
+			std::vector< struct epoll_event > events( socketListeners_.size() + 1 );
+			std::vector< std::size_t > pending;
+			pending.reserve( socketListeners_.size() );
+			std::vector< bool > isPending( socketListeners_.size(), false );
+
+			while( !break_ ){
+
+				// don't block while sockets still have unread data
+				int timeoutMs = -1;
+				if( !pending.empty() )
+					timeoutMs = 0;
+				else if( !timerQueue.empty() )
+					timeoutMs = (int)std::min( (TimeUntilNextTimerNs( timerQueue ) + 999999) / 1000000, (uint64_t)INT_MAX );
+
+				int eventCount = epoll_wait( epollFd, &events[0], (int)events.size(), timeoutMs );
+				if( eventCount < 0 ){
+					if( break_ ){
+						break;
+					}else if( errno == EINTR ){
+						continue;
+					}else{
+						throw std::runtime_error("epoll_wait failed\n");
+					}
+				}
+
+				for( int i = 0; i < eventCount; ++i ){
+					if( events[i].data.u64 == 0 ){
+						// clear pending data from the asynchronous break pipe
+						char c;
+						read( breakPipe_[0], &c, 1 );
+					}else{
+						std::size_t index = (std::size_t)(events[i].data.u64 - 1);
+						if( !isPending[index] ){
+							isPending[index] = true;
+							pending.push_back( index );
+						}
+					}
+				}
+
+				if( break_ )
+					break;
+
+				std::size_t stillPending = 0;
+				for( std::size_t i = 0; i < pending.size(); ++i ){
+					std::size_t index = pending[i];
+					bool drained = false;
+
+					for( int j = 0; j < MAX_DATAGRAMS_PER_WAKEUP && !break_; ++j ){
+						std::size_t size;
+						if( !socketListeners_[index].second->impl_->TryReceiveFrom( remoteEndpoint, data, packetBuffers_.BufferSize(), size ) ){
+							drained = true;
+							break;
+						}
+						if( size > 0 )
+							DispatchPacket( socketListeners_[index].first, data, size, remoteEndpoint );
+					}
+
+					if( drained )
+						isPending[index] = false;
+					else
+						pending[stillPending++] = index;
+				}
+				pending.resize( stillPending );
+
+				// execute any expired timers
+				ExecuteExpiredTimers( timerQueue );
+			}
+
+			packetBuffers_.Release( data );
+			close( epollFd );
+		}catch(...){
+			if( data )
+				packetBuffers_.Release( data );
+			close( epollFd );
+			throw;
+		}
+	}
+
+#endif /* OSC_HAVE_EPOLL */
+
+public:
+    Implementation( NotificationMode mode )
+		: mode_( mode )
+		, packetBuffers_( SocketReceiveMultiplexer::DEFAULT_DATAGRAM_SIZE )
+		, currentPacket_( 0 )
+		, currentPacketRetained_( false )
+	{
+		if( pipe(breakPipe_) != 0 )
+			throw std::runtime_error( "creation of asynchronous break pipes failed\n" );
+
+		// non-blocking at both ends: a full pipe already guarantees a wakeup,
+		// so AsynchronousBreak() never needs to block, and Run() can drain
+		// what earlier breaks left behind.
+		fcntl( breakPipe_[0], F_SETFL, fcntl( breakPipe_[0], F_GETFL ) | O_NONBLOCK );
+		fcntl( breakPipe_[1], F_SETFL, fcntl( breakPipe_[1], F_GETFL ) | O_NONBLOCK );
+	}
+
+    ~Implementation()
+	{
+		close( breakPipe_[0] );
+		close( breakPipe_[1] );
+	}
+
+    void AttachSocketListener( UdpSocket *socket, PacketListener *listener )
+	{
+		assert( std::find( socketListeners_.begin(), socketListeners_.end(), std::make_pair(listener, socket) ) == socketListeners_.end() );
+		// we don't check that the same socket has been added multiple times, even though this is an error
+		socketListeners_.push_back( std::make_pair( listener, socket ) );
+	}
+
+    void DetachSocketListener( UdpSocket *socket, PacketListener *listener )
+	{
+		std::vector< std::pair< PacketListener*, UdpSocket* > >::iterator i = 
+				std::find( socketListeners_.begin(), socketListeners_.end(), std::make_pair(listener, socket) );
+		assert( i != socketListeners_.end() );
+
+		socketListeners_.erase( i );
+	}
+
+    void AttachPeriodicTimerListener( int periodMilliseconds, TimerListener *listener )
+	{
+		timerListeners_.push_back( AttachedTimerListener( periodMilliseconds, periodMilliseconds, listener ) );
+	}
+
+	void AttachPeriodicTimerListener( int initialDelayMilliseconds, int periodMilliseconds, TimerListener *listener )
+	{
+		timerListeners_.push_back( AttachedTimerListener( initialDelayMilliseconds, periodMilliseconds, listener ) );
+	}
+
+    void DetachPeriodicTimerListener( TimerListener *listener )
+	{
+		std::vector< AttachedTimerListener >::iterator i = timerListeners_.begin();
+		while( i != timerListeners_.end() ){
+			if( i->listener == listener )
+				break;
+			++i;
+		}
+
+		assert( i != timerListeners_.end() );
+
+		timerListeners_.erase( i );
+	}
+
+	void SetMaximumDatagramSize( std::size_t size )
+	{
+		if( size == 0 || size > SocketReceiveMultiplexer::MAX_DATAGRAM_SIZE )
+			throw std::runtime_error( "maximum datagram size out of range\n" );
+
+		packetBuffers_.SetBufferSize( size );
+	}
+
+	std::size_t MaximumDatagramSize() const
+	{
+		return packetBuffers_.BufferSize();
+	}
+
+	char *RetainPacketBuffer()
+	{
+		assert( currentPacket_ != 0 && !currentPacketRetained_ ); // only call from ProcessPacket(), once
+		currentPacketRetained_ = true;
+		return currentPacket_;
+	}
+
+	void ReleasePacketBuffer( char *data )
+	{
+		packetBuffers_.Release( data );
+	}
+
+    void Run()
+	{
+		break_ = false;
+
+		// discard break messages sent after a previous run had already
+		// stopped, so they don't cause spurious wakeups in this one
+		char drain[64];
+		while( read( breakPipe_[0], drain, sizeof(drain) ) > 0 )
+			;
+
+#ifdef OSC_HAVE_EPOLL
+		if( mode_ == EPOLL_NOTIFICATION ){
+			RunEpoll();
+			return;
+		}
+#endif
+
+		RunSelect();
+	}
+
     void Break()
 	{
 		break_ = true;
@@ -542,7 +1024,12 @@ public:
 
 SocketReceiveMultiplexer::SocketReceiveMultiplexer()
 {
-	impl_ = new Implementation();
+	impl_ = new Implementation( SELECT_NOTIFICATION );
+}
+
+SocketReceiveMultiplexer::SocketReceiveMultiplexer( NotificationMode mode )
+{
+	impl_ = new Implementation( mode );
 }
 
 SocketReceiveMultiplexer::~SocketReceiveMultiplexer()
@@ -575,6 +1062,26 @@ void SocketReceiveMultiplexer::DetachPeriodicTimerListener( TimerListener *liste
 	impl_->DetachPeriodicTimerListener( listener );
 }
 
+void SocketReceiveMultiplexer::SetMaximumDatagramSize( std::size_t size )
+{
+	impl_->SetMaximumDatagramSize( size );
+}
+
+std::size_t SocketReceiveMultiplexer::MaximumDatagramSize() const
+{
+	return impl_->MaximumDatagramSize();
+}
+
+char *SocketReceiveMultiplexer::RetainPacketBuffer()
+{
+	return impl_->RetainPacketBuffer();
+}
+
+void SocketReceiveMultiplexer::ReleasePacketBuffer( char *data )
+{
+	impl_->ReleasePacketBuffer( data );
+}
+
 void SocketReceiveMultiplexer::Run()
 {
 	impl_->Run();
@@ -137,6 +137,12 @@ public:
 		setsockopt(socket_, SOL_SOCKET, SO_REUSEADDR, &reuseAddr, sizeof(reuseAddr));
 	}
 
+	void SetReusePort( bool )
+	{
+		// winsock has no equivalent that shares datagrams between sockets
+		throw std::runtime_error("SO_REUSEPORT is not supported\n");
+	}
+
 	IpEndpointName LocalEndpointFor( const IpEndpointName& remoteEndpoint ) const
 	{
 		assert( isBound_ );
@@ -262,6 +268,11 @@ void UdpSocket::SetAllowReuse( bool allowReuse )
     impl_->SetAllowReuse( allowReuse );
 }
 
+void UdpSocket::SetReusePort( bool reusePort )
+{
+    impl_->SetReusePort( reusePort );
+}
+
 IpEndpointName UdpSocket::LocalEndpointFor( const IpEndpointName& remoteEndpoint ) const
 {
 	return impl_->LocalEndpointFor( remoteEndpoint );
@@ -297,6 +308,23 @@ std::size_t UdpSocket::ReceiveFrom( IpEndpointName& remoteEndpoint, char *data,
 	return impl_->ReceiveFrom( remoteEndpoint, data, size );
 }
 
+std::size_t UdpSocket::ReceiveBatch( UdpDatagram *datagrams, std::size_t count )
+{
+	// winsock has no batched receive, deliver one datagram per call
+	if( count == 0 )
+		return 0;
+
+	datagrams[0].size = impl_->ReceiveFrom( datagrams[0].remoteEndpoint, datagrams[0].data, datagrams[0].capacity );
+	return (datagrams[0].size > 0) ? 1 : 0;
+}
+
+std::size_t UdpSocket::SendBatch( const UdpDatagram *datagrams, std::size_t count )
+{
+	for( std::size_t i = 0; i < count; ++i )
+		impl_->Send( datagrams[i].data, datagrams[i].size );
+	return count;
+}
+
 
 struct AttachedTimerListener{
 	AttachedTimerListener( int id, int p, TimerListener *tl )
@@ -328,6 +356,90 @@ extern "C" /*static*/ void InterruptSignalHandler( int );
 }
 
 
+// receive buffers of a single size, recycled across packets and calls to
+// Run(). Release() may be called from any thread.
+class PacketBufferPool{
+	std::vector< char* > free_;
+	std::size_t bufferSize_;
+	std::size_t outstandingCount_;
+	CRITICAL_SECTION lock_;
+
+	void DeleteFreeBuffers()
+	{
+		for( std::vector< char* >::iterator i = free_.begin(); i != free_.end(); ++i )
+			delete [] *i;
+		free_.clear();
+	}
+
+public:
+	PacketBufferPool( std::size_t bufferSize )
+		: bufferSize_( bufferSize )
+		, outstandingCount_( 0 )
+	{
+		InitializeCriticalSection( &lock_ );
+	}
+
+	~PacketBufferPool()
+	{
+		assert( outstandingCount_ == 0 );
+		DeleteFreeBuffers();
+		DeleteCriticalSection( &lock_ );
+	}
+
+	std::size_t BufferSize() const { return bufferSize_; }
+
+	// buffers handed out at the old size would otherwise come back into
+	// the pool and be received into at the new one
+	void SetBufferSize( std::size_t bufferSize )
+	{
+		EnterCriticalSection( &lock_ );
+		if( outstandingCount_ != 0 ){
+			LeaveCriticalSection( &lock_ );
+			throw std::runtime_error( "cannot change the datagram size while packet buffers are in use\n" );
+		}
+		DeleteFreeBuffers();
+		bufferSize_ = bufferSize;
+		LeaveCriticalSection( &lock_ );
+	}
+
+	char *Acquire()
+	{
+		char *buffer = 0;
+		EnterCriticalSection( &lock_ );
+		if( !free_.empty() ){
+			buffer = free_.back();
+			free_.pop_back();
+		}
+		++outstandingCount_;
+		LeaveCriticalSection( &lock_ );
+
+		if( !buffer ){
+			try{
+				buffer = new char[ bufferSize_ ];
+			}catch(...){
+				EnterCriticalSection( &lock_ );
+				--outstandingCount_;
+				LeaveCriticalSection( &lock_ );
+				throw;
+			}
+		}
+		return buffer;
+	}
+
+	void Release( char *buffer )
+	{
+		EnterCriticalSection( &lock_ );
+		try{
+			free_.push_back( buffer );
+		}catch(...){
+			delete [] buffer;
+		}
+		--outstandingCount_;
+		LeaveCriticalSection( &lock_ );
+	}
+};
+
+
 class SocketReceiveMultiplexer::Implementation{
     NetworkInitializer networkInitializer_;
 
@@ -337,6 +449,32 @@ class SocketReceiveMultiplexer::Implementation{
 	volatile bool break_;
 	HANDLE breakEvent_;
 
+	PacketBufferPool packetBuffers_;
+	char *currentPacket_; // the buffer passed to ProcessPacket(), zero outside it
+	bool currentPacketRetained_;
+
+	// passes the packet in data to listener. if the listener retains the
+	// buffer, data is replaced with a fresh one from the pool.
+	void DispatchPacket( PacketListener *listener, char *&data, std::size_t size, const IpEndpointName& remoteEndpoint )
+	{
+		currentPacket_ = data;
+		currentPacketRetained_ = false;
+		try{
+			listener->ProcessPacket( data, (int)size, remoteEndpoint );
+		}catch(...){
+			if( currentPacketRetained_ )
+				data = 0;
+			currentPacket_ = 0;
+			throw;
+		}
+		currentPacket_ = 0;
+
+		if( currentPacketRetained_ ){
+			data = 0;
+			data = packetBuffers_.Acquire();
+		}
+	}
+
 	double GetCurrentTimeMs() const
 	{
 #ifndef WINCE
@@ -348,6 +486,9 @@ class SocketReceiveMultiplexer::Implementation{
 
 public:
     Implementation()
+		: packetBuffers_( SocketReceiveMultiplexer::DEFAULT_DATAGRAM_SIZE )
+		, currentPacket_( 0 )
+		, currentPacketRetained_( false )
 	{
 		breakEvent_ = CreateEvent( NULL, FALSE, FALSE, NULL );
 	}
@@ -429,55 +570,61 @@ public:
 			timerQueue_.push_back( std::make_pair( currentTimeMs + i->initialDelayMs, *i ) );
 		std::sort( timerQueue_.begin(), timerQueue_.end(), CompareScheduledTimerCalls );
 
-		const int MAX_BUFFER_SIZE = 4098;
-		char *data = new char[ MAX_BUFFER_SIZE ];
-		IpEndpointName remoteEndpoint;
+		char *data = 0;
+		try{
+			data = packetBuffers_.Acquire();
+			IpEndpointName remoteEndpoint;
 
-		while( !break_ ){
+			while( !break_ ){
 
-			double currentTimeMs = GetCurrentTimeMs();
+				double currentTimeMs = GetCurrentTimeMs();
 
-            DWORD waitTime = INFINITE;
-            if( !timerQueue_.empty() ){
+	            DWORD waitTime = INFINITE;
+	            if( !timerQueue_.empty() ){
 
-                waitTime = (DWORD)( timerQueue_.front().first >= currentTimeMs
-                            ? timerQueue_.front().first - currentTimeMs
-                            : 0 );
-            }
+	                waitTime = (DWORD)( timerQueue_.front().first >= currentTimeMs
+	                            ? timerQueue_.front().first - currentTimeMs
+	                            : 0 );
+	            }
 
-			DWORD waitResult = WaitForMultipleObjects( (DWORD)socketListeners_.size() + 1, &events[0], FALSE, waitTime );
-			if( break_ )
-				break;
+				DWORD waitResult = WaitForMultipleObjects( (DWORD)socketListeners_.size() + 1, &events[0], FALSE, waitTime );
+				if( break_ )
+					break;
 
-			if( waitResult != WAIT_TIMEOUT ){
-				for( int i = waitResult - WAIT_OBJECT_0; i < (int)socketListeners_.size(); ++i ){
-					std::size_t size = socketListeners_[i].second->ReceiveFrom( remoteEndpoint, data, MAX_BUFFER_SIZE );
-					if( size > 0 ){
-						socketListeners_[i].first->ProcessPacket( data, (int)size, remoteEndpoint );
-						if( break_ )
-							break;
+				if( waitResult != WAIT_TIMEOUT ){
+					for( int i = waitResult - WAIT_OBJECT_0; i < (int)socketListeners_.size(); ++i ){
+						std::size_t size = socketListeners_[i].second->ReceiveFrom( remoteEndpoint, data, packetBuffers_.BufferSize() );
+						if( size > 0 ){
+							DispatchPacket( socketListeners_[i].first, data, size, remoteEndpoint );
+							if( break_ )
+								break;
+						}
 					}
 				}
-			}
 
-			// execute any expired timers
-			currentTimeMs = GetCurrentTimeMs();
-			bool resort = false;
-			for( std::vector< std::pair< double, AttachedTimerListener > >::iterator i = timerQueue_.begin();
-					i != timerQueue_.end() && i->first <= currentTimeMs; ++i ){
+				// execute any expired timers
+				currentTimeMs = GetCurrentTimeMs();
+				bool resort = false;
+				for( std::vector< std::pair< double, AttachedTimerListener > >::iterator i = timerQueue_.begin();
+						i != timerQueue_.end() && i->first <= currentTimeMs; ++i ){
 
-				i->second.listener->TimerExpired();
-				if( break_ )
-					break;
+					i->second.listener->TimerExpired();
+					if( break_ )
+						break;
 
-				i->first += i->second.periodMs;
-				resort = true;
+					i->first += i->second.periodMs;
+					resort = true;
+				}
+				if( resort )
+					std::sort( timerQueue_.begin(), timerQueue_.end(), CompareScheduledTimerCalls );
 			}
-			if( resort )
-				std::sort( timerQueue_.begin(), timerQueue_.end(), CompareScheduledTimerCalls );
-		}
 
-		delete [] data;
+			packetBuffers_.Release( data );
+		}catch(...){
+			if( data )
+				packetBuffers_.Release( data );
+			throw;
+		}
 
 		// free events
 		j = 0;
@@ -491,6 +638,31 @@ public:
 		}
 	}
 
+	void SetMaximumDatagramSize( std::size_t size )
+	{
+		if( size == 0 || size > SocketReceiveMultiplexer::MAX_DATAGRAM_SIZE )
+			throw std::runtime_error( "maximum datagram size out of range\n" );
+
+		packetBuffers_.SetBufferSize( size );
+	}
+
+	std::size_t MaximumDatagramSize() const
+	{
+		return packetBuffers_.BufferSize();
+	}
+
+	char *RetainPacketBuffer()
+	{
+		assert( currentPacket_ != 0 && !currentPacketRetained_ ); // only call from ProcessPacket(), once
+		currentPacketRetained_ = true;
+		return currentPacket_;
+	}
+
+	void ReleasePacketBuffer( char *data )
+	{
+		packetBuffers_.Release( data );
+	}
+
     void Break()
 	{
 		break_ = true;
@@ -510,6 +682,12 @@ SocketReceiveMultiplexer::SocketReceiveMultiplexer()
 	impl_ = new Implementation();
 }
 
+SocketReceiveMultiplexer::SocketReceiveMultiplexer( NotificationMode )
+{
+	// WSAWaitForMultipleEvents is the only notification mechanism used on win32
+	impl_ = new Implementation();
+}
+
 SocketReceiveMultiplexer::~SocketReceiveMultiplexer()
 {	
 	delete impl_;
@@ -540,6 +718,26 @@ void SocketReceiveMultiplexer::DetachPeriodicTimerListener( TimerListener *liste
 	impl_->DetachPeriodicTimerListener( listener );
 }
 
+void SocketReceiveMultiplexer::SetMaximumDatagramSize( std::size_t size )
+{
+	impl_->SetMaximumDatagramSize( size );
+}
+
+std::size_t SocketReceiveMultiplexer::MaximumDatagramSize() const
+{
+	return impl_->MaximumDatagramSize();
+}
+
+char *SocketReceiveMultiplexer::RetainPacketBuffer()
+{
+	return impl_->RetainPacketBuffer();
+}
+
+void SocketReceiveMultiplexer::ReleasePacketBuffer( char *data )
+{
+	impl_->ReleasePacketBuffer( data );
+}
+
 void SocketReceiveMultiplexer::Run()
 {
 	impl_->Run();
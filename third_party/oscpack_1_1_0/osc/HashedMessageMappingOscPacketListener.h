@@ -0,0 +1,308 @@
+/*
+	oscpack -- Open Sound Control (OSC) packet manipulation library
+    http://www.rossbencina.com/code/oscpack
+
+    Copyright (c) 2004-2013 Ross Bencina <rossb@audiomulch.com>
+
+	Permission is hereby granted, free of charge, to any person obtaining
+	a copy of this software and associated documentation files
+	(the "Software"), to deal in the Software without restriction,
+	including without limitation the rights to use, copy, modify, merge,
+	publish, distribute, sublicense, and/or sell copies of the Software,
+	and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+	MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+	IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+	ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+	WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+/*
+	The text above constitutes the entire oscpack license; however, 
+	the oscpack developer(s) also make the following non-binding requests:
+
+	Any person wishing to distribute modifications to the Software is
+	requested to send the modifications to the original developer so that
+	they can be incorporated into the canonical version. It is also 
+	requested that these non-binding requests be included whenever the
+	above license is reproduced.
+*/
+#ifndef INCLUDED_OSCPACK_HASHEDMESSAGEMAPPINGOSCPACKETLISTENER_H
+#define INCLUDED_OSCPACK_HASHEDMESSAGEMAPPINGOSCPACKETLISTENER_H
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include "OscPacketListener.h"
+#include "OscTypes.h"
+
+
+
+namespace osc{
+
+/*
+    A drop-in alternative to MessageMappingOscPacketListener for large
+    address spaces. Registered addresses live in an open addressing hash
+    table keyed on the 4-byte words of the address, so an exact match costs
+    one hash over the (already padded) address and usually a single
+    compare, instead of O(log n) strcmp calls. Handlers are called through
+    a static_cast rather than a dynamic_cast.
+
+    When no address matches exactly and the incoming address contains OSC
+    pattern characters ('?', '*', '[', '{' or '//'), it is matched as a
+    pattern against every registered address, and each match is dispatched
+    in registration order.
+
+    Unlike MessageMappingOscPacketListener, registered address strings are
+    copied, so they need not outlive the call.
+*/
+template< class T >
+class HashedMessageMappingOscPacketListener : public OscPacketListener{
+public:
+    typedef void (T::*function_type)(const osc::ReceivedMessage&, const IpEndpointName&);
+
+    HashedMessageMappingOscPacketListener()
+        : slots_( INITIAL_SLOT_COUNT, 0 ) {}
+
+protected:
+    void RegisterMessageFunction( const char *addressPattern, function_type f )
+    {
+        Entry entry;
+        entry.keyOffset = keys_.size();
+        entry.wordCount = AppendWords( addressPattern, keys_ );
+        entry.hash = Hash( &keys_[entry.keyOffset], entry.wordCount );
+        entry.function = f;
+
+        if( Find( &keys_[entry.keyOffset], entry.wordCount, entry.hash ) != 0 ){
+            // like std::map::insert, keep the first registration
+            keys_.resize( entry.keyOffset );
+            return;
+        }
+
+        entries_.push_back( entry );
+        if( entries_.size() * 2 > slots_.size() )
+            Rehash( slots_.size() * 2 );
+        else
+            Insert( entries_.size() - 1 );
+    }
+
+    virtual void ProcessMessage( const osc::ReceivedMessage& m,
+		const IpEndpointName& remoteEndpoint )
+    {
+        const char *address = m.AddressPattern();
+        uint32 words[ MAX_INLINE_WORDS ];
+        std::vector<uint32> longWords;
+        std::size_t wordCount = LoadWords( address, words, longWords );
+        const uint32 *key = ( longWords.empty() ) ? words : &longWords[0];
+
+        if( const Entry *entry = Find( key, wordCount, Hash( key, wordCount ) ) ){
+            (static_cast<T*>(this)->*(entry->function))( m, remoteEndpoint );
+            return;
+        }
+
+        if( IsPattern( address ) ){
+            for( std::size_t i = 0; i < entries_.size(); ++i ){
+                const char *candidate = reinterpret_cast<const char*>( &keys_[entries_[i].keyOffset] );
+                if( PatternMatches( address, candidate ) )
+                    (static_cast<T*>(this)->*(entries_[i].function))( m, remoteEndpoint );
+            }
+        }
+    }
+
+private:
+    enum { INITIAL_SLOT_COUNT = 16, MAX_INLINE_WORDS = 64 };
+
+    struct Entry{
+        std::size_t keyOffset;  // into keys_
+        std::size_t wordCount;  // including the word holding the terminator
+        uint32 hash;
+        function_type function;
+    };
+
+    std::vector<uint32> keys_;      // registered addresses, each zero padded to whole words
+    std::vector<Entry> entries_;    // in registration order
+    std::vector<std::size_t> slots_;  // index into entries_ plus one, 0 when empty
+
+    static std::size_t AppendWords( const char *s, std::vector<uint32>& words )
+    {
+        std::size_t length = std::strlen( s );
+        std::size_t count = length / 4 + 1;
+        std::size_t offset = words.size();
+        words.resize( offset + count, 0 );
+        std::memcpy( &words[offset], s, length );
+        return count;
+    }
+
+    // Reads an address from a received message a word at a time. Bytes
+    // after the terminator in its last word are not guaranteed to be zero,
+    // so they are masked off.
+    static std::size_t LoadWords( const char *s, uint32 *words, std::vector<uint32>& longWords )
+    {
+        for( std::size_t i = 0; ; ++i ){
+            if( i == MAX_INLINE_WORDS ){
+                // an unusually long address: fall back to the heap
+                AppendWords( s, longWords );
+                return longWords.size();
+            }
+
+            uint32 word;
+            std::memcpy( &word, s + i * 4, 4 );
+            if( ((word - 0x01010101u) & ~word & 0x80808080u) != 0 ){   // has a zero byte
+                char last[4] = { 0, 0, 0, 0 };
+                for( int j = 0; j < 4 && s[i * 4 + j]; ++j )
+                    last[j] = s[i * 4 + j];
+                std::memcpy( &words[i], last, 4 );
+                return i + 1;
+            }
+            words[i] = word;
+        }
+    }
+
+    static uint32 Hash( const uint32 *words, std::size_t count )
+    {
+        uint32 h = 2166136261u;
+        for( std::size_t i = 0; i < count; ++i )
+            h = ( h ^ words[i] ) * 16777619u;
+        return h ^ ( h >> 15 );
+    }
+
+    const Entry *Find( const uint32 *key, std::size_t wordCount, uint32 hash ) const
+    {
+        std::size_t mask = slots_.size() - 1;
+        for( std::size_t i = hash & mask; slots_[i] != 0; i = ( i + 1 ) & mask ){
+            const Entry& entry = entries_[ slots_[i] - 1 ];
+            if( entry.hash == hash && entry.wordCount == wordCount
+                    && std::memcmp( &keys_[entry.keyOffset], key, wordCount * 4 ) == 0 )
+                return &entry;
+        }
+        return 0;
+    }
+
+    void Insert( std::size_t index )
+    {
+        std::size_t mask = slots_.size() - 1;
+        std::size_t i = entries_[index].hash & mask;
+        while( slots_[i] != 0 )
+            i = ( i + 1 ) & mask;
+        slots_[i] = index + 1;
+    }
+
+    void Rehash( std::size_t slotCount )
+    {
+        slots_.assign( slotCount, 0 );
+        for( std::size_t i = 0; i < entries_.size(); ++i )
+            Insert( i );
+    }
+
+    static bool IsPattern( const char *s )
+    {
+        return std::strpbrk( s, "?*[{" ) != 0 || std::strstr( s, "//" ) != 0;
+    }
+
+    // OSC 1.0 address pattern matching, plus the OSC 1.1 '//' wildcard.
+    // '?', '*' and bracketed classes never match a '/'.
+    static bool PatternMatches( const char *p, const char *a )
+    {
+        for( ; *p; ++p ){
+            switch( *p ){
+            case '?':
+                if( *a == '\0' || *a == '/' )
+                    return false;
+                ++a;
+                break;
+
+            case '*':
+                while( p[1] == '*' )
+                    ++p;
+                for( ; ; ++a ){
+                    if( PatternMatches( p + 1, a ) )
+                        return true;
+                    if( *a == '\0' || *a == '/' )
+                        return false;
+                }
+
+            case '[':
+                {
+                    if( *a == '\0' || *a == '/' )
+                        return false;
+                    const char *q = p + 1;
+                    bool negate = ( *q == '!' );
+                    if( negate )
+                        ++q;
+                    bool matched = false;
+                    for( ; *q && *q != ']'; ++q ){
+                        if( q[1] == '-' && q[2] && q[2] != ']' ){
+                            if( *a >= q[0] && *a <= q[2] )
+                                matched = true;
+                            q += 2;
+                        }else if( *q == *a ){
+                            matched = true;
+                        }
+                    }
+                    if( *q != ']' || matched == negate )
+                        return false;
+                    p = q;
+                    ++a;
+                }
+                break;
+
+            case '{':
+                {
+                    const char *end = std::strchr( p, '}' );
+                    if( !end )
+                        return false;
+                    for( const char *alternative = p + 1; ; ){
+                        const char *alternativeEnd = alternative;
+                        while( alternativeEnd != end && *alternativeEnd != ',' )
+                            ++alternativeEnd;
+                        std::size_t length = alternativeEnd - alternative;
+                        if( std::strncmp( alternative, a, length ) == 0
+                                && PatternMatches( end + 1, a + length ) )
+                            return true;
+                        if( alternativeEnd == end )
+                            return false;
+                        alternative = alternativeEnd + 1;
+                    }
+                }
+
+            case '/':
+                if( p[1] == '/' ){
+                    // any number of parts, continuing from one of the remaining '/'
+                    while( p[1] == '/' )
+                        ++p;
+                    if( *a != '/' )
+                        return false;
+                    for( const char *s = a; s; s = std::strchr( s + 1, '/' ) ){
+                        if( PatternMatches( p, s ) )
+                            return true;
+                    }
+                    return false;
+                }
+                // a single '/' is matched literally
+                if( *a != '/' )
+                    return false;
+                ++a;
+                break;
+
+            default:
+                if( *p != *a )
+                    return false;
+                ++a;
+                break;
+            }
+        }
+        return *a == '\0';
+    }
+};
+
+} // namespace osc
+
+#endif /* INCLUDED_OSCPACK_HASHEDMESSAGEMAPPINGOSCPACKETLISTENER_H */
\ No newline at end of file
@@ -0,0 +1,122 @@
+/*
+	oscpack -- Open Sound Control (OSC) packet manipulation library
+    http://www.rossbencina.com/code/oscpack
+
+    Copyright (c) 2004-2013 Ross Bencina <rossb@audiomulch.com>
+
+	Permission is hereby granted, free of charge, to any person obtaining
+	a copy of this software and associated documentation files
+	(the "Software"), to deal in the Software without restriction,
+	including without limitation the rights to use, copy, modify, merge,
+	publish, distribute, sublicense, and/or sell copies of the Software,
+	and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+	MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+	IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+	ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+	WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+/*
+	The text above constitutes the entire oscpack license; however, 
+	the oscpack developer(s) also make the following non-binding requests:
+
+	Any person wishing to distribute modifications to the Software is
+	requested to send the modifications to the original developer so that
+	they can be incorporated into the canonical version. It is also 
+	requested that these non-binding requests be included whenever the
+	above license is reproduced.
+*/
+#ifndef INCLUDED_OSCPACK_OSCBYTESWAP_H
+#define INCLUDED_OSCPACK_OSCBYTESWAP_H
+
+#include <cstring> // size_t, memcpy
+
+#include "OscHostEndianness.h"
+
+#if defined(OSC_HOST_LITTLE_ENDIAN) && !defined(OSC_NO_SIMD)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+#endif
+
+
+namespace osc{
+
+/*
+    Copy count 4-byte values from src to dest, converting between host and
+    network (big endian) byte order. The conversion is its own inverse so
+    the same routine serves both encoding and decoding. Neither pointer
+    needs to be aligned, and the ranges must not overlap.
+
+    The widest vector unit enabled at compile time is used: AVX2 or SSSE3
+    byte shuffles, SSE2 shifts, or NEON byte reversal, with a scalar loop
+    for the remainder. Build with e.g. -mavx2 to select the wider paths, or
+    define OSC_NO_SIMD to use the scalar loop only.
+*/
+inline void CopySwapped32( char *dest, const char *src, std::size_t count )
+{
+#if defined(OSC_HOST_BIG_ENDIAN)
+    std::memcpy( dest, src, count * 4 );
+#else
+    std::size_t i = 0;
+
+#if defined(OSC_NO_SIMD)
+    // scalar loop only
+#elif defined(__AVX2__)
+    const __m256i reverse = _mm256_setr_epi8(
+            3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+            3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 );
+    for( ; i + 8 <= count; i += 8 ){
+        __m256i v = _mm256_loadu_si256( reinterpret_cast<const __m256i*>(src + i * 4) );
+        _mm256_storeu_si256( reinterpret_cast<__m256i*>(dest + i * 4), _mm256_shuffle_epi8( v, reverse ) );
+    }
+#elif defined(__SSSE3__)
+    const __m128i reverse = _mm_setr_epi8( 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 );
+    for( ; i + 4 <= count; i += 4 ){
+        __m128i v = _mm_loadu_si128( reinterpret_cast<const __m128i*>(src + i * 4) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>(dest + i * 4), _mm_shuffle_epi8( v, reverse ) );
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    // no byte shuffle in SSE2: swap the 16-bit halves of each word, then
+    // the bytes of each half.
+    for( ; i + 4 <= count; i += 4 ){
+        __m128i v = _mm_loadu_si128( reinterpret_cast<const __m128i*>(src + i * 4) );
+        v = _mm_shufflehi_epi16( _mm_shufflelo_epi16( v, 0xB1 ), 0xB1 );
+        v = _mm_or_si128( _mm_slli_epi16( v, 8 ), _mm_srli_epi16( v, 8 ) );
+        _mm_storeu_si128( reinterpret_cast<__m128i*>(dest + i * 4), v );
+    }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    for( ; i + 4 <= count; i += 4 ){
+        uint8x16_t v = vld1q_u8( reinterpret_cast<const uint8_t*>(src + i * 4) );
+        vst1q_u8( reinterpret_cast<uint8_t*>(dest + i * 4), vrev32q_u8( v ) );
+    }
+#endif
+
+    for( ; i < count; ++i ){
+        const char *s = src + i * 4;
+        char *d = dest + i * 4;
+        d[0] = s[3];
+        d[1] = s[2];
+        d[2] = s[1];
+        d[3] = s[0];
+    }
+#endif
+}
+
+} // namespace osc
+
+#endif /* INCLUDED_OSCPACK_OSCBYTESWAP_H */
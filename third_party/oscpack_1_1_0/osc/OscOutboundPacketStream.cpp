@@ -48,6 +48,7 @@
 #include <cstddef> // ptrdiff_t
 
 #include "OscHostEndianness.h"
+#include "OscByteSwap.h"
 
 #if defined(__BORLANDC__) // workaround for BCB4 release build intrinsics bug
 namespace std {
@@ -264,6 +265,17 @@ void OutboundPacketStream::CheckForAvailableArgumentSpace( std::size_t argumentL
 }
 
 
+void OutboundPacketStream::CheckForAvailableArgumentSpace( std::size_t argumentLength, std::size_t typeTagCount )
+{
+    // plus two for comma and null terminator
+    std::size_t required = (argumentCurrent_ - data_) + argumentLength
+            + RoundUp4( (end_ - typeTagsCurrent_) + typeTagCount + 2 );
+
+    if( required > Capacity() )
+        throw OutOfBufferMemoryException();
+}
+
+
 void OutboundPacketStream::Clear()
 {
     typeTagsCurrent_ = end_;
@@ -678,6 +690,40 @@ OutboundPacketStream& OutboundPacketStream::operator<<( const ArrayTerminator& r
     return *this;
 }
 
+
+void OutboundPacketStream::Append32BitArray( const void *values, std::size_t count, char typeTag )
+{
+    // guard the multiplication below against overflow, anything this large
+    // can't fit in the buffer anyway
+    if( count > Capacity() )
+        throw OutOfBufferMemoryException();
+
+    CheckForAvailableArgumentSpace( count * 4, count );
+
+    // type tags are stored in reverse order, but they're all the same here
+    typeTagsCurrent_ -= count;
+    std::memset( typeTagsCurrent_, typeTag, count );
+
+    CopySwapped32( argumentCurrent_, static_cast<const char*>(values), count );
+    argumentCurrent_ += count * 4;
+}
+
+
+OutboundPacketStream& OutboundPacketStream::AppendInt32Array( const int32 *values, std::size_t count )
+{
+    Append32BitArray( values, count, INT32_TYPE_TAG );
+
+    return *this;
+}
+
+
+OutboundPacketStream& OutboundPacketStream::AppendFloatArray( const float *values, std::size_t count )
+{
+    Append32BitArray( values, count, FLOAT_TYPE_TAG );
+
+    return *this;
+}
+
 } // namespace osc
 
 
@@ -124,6 +124,12 @@ public:
     OutboundPacketStream& operator<<( const ArrayInitiator& rhs );
     OutboundPacketStream& operator<<( const ArrayTerminator& rhs );
 
+    // append count int32 or float arguments in one step. equivalent to
+    // streaming each value with operator<<, but the space check, type tags
+    // and byte swapping are done for the whole array at once.
+    OutboundPacketStream& AppendInt32Array( const int32 *values, std::size_t count );
+    OutboundPacketStream& AppendFloatArray( const float *values, std::size_t count );
+
 private:
 
     char *BeginElement( char *beginPtr );
@@ -133,6 +139,8 @@ private:
     void CheckForAvailableBundleSpace();
     void CheckForAvailableMessageSpace( const char *addressPattern );
     void CheckForAvailableArgumentSpace( std::size_t argumentLength );
+    void CheckForAvailableArgumentSpace( std::size_t argumentLength, std::size_t typeTagCount );
+    void Append32BitArray( const void *values, std::size_t count, char typeTag );
 
     char *data_;
     char *end_;
@@ -37,12 +37,156 @@
 #include "OscReceivedElements.h"
 
 #include "OscHostEndianness.h"
+#include "OscByteSwap.h"
 
 #include <cstddef> // ptrdiff_t
 
+/*
+    ReceivedMessage::Init() validates 16 or 32 type tags, and searches 16 or
+    32 string bytes for a terminator, per step when SSE2 (the x86-64
+    baseline) or AVX2 is enabled at compile time. Define OSC_NO_SIMD to
+    use the byte-at-a-time code everywhere.
+*/
+#if !defined(OSC_NO_SIMD)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define OSC_VALIDATE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define OSC_VALIDATE_SSE2
+#endif
+#endif
+
+#if defined(_MSC_VER) && (defined(OSC_VALIDATE_AVX2) || defined(OSC_VALIDATE_SSE2))
+#include <intrin.h> // _BitScanForward
+#endif
+
 namespace osc{
 
 
+#if defined(OSC_VALIDATE_AVX2) || defined(OSC_VALIDATE_SSE2)
+
+#if defined(OSC_VALIDATE_AVX2)
+
+typedef __m256i ByteVector;
+static const std::size_t BYTE_VECTOR_SIZE = 32;
+static const uint32 BYTE_VECTOR_ALL = 0xFFFFFFFF;
+static const uint32 BYTE_VECTOR_WORD_ENDS = 0x88888888; // byte 3 of each 4-byte word
+
+static inline ByteVector LoadByteVector( const char *p )
+    { return _mm256_loadu_si256( reinterpret_cast<const __m256i*>(p) ); }
+static inline ByteVector EqualBytes( ByteVector v, char c )
+    { return _mm256_cmpeq_epi8( v, _mm256_set1_epi8( c ) ); }
+static inline ByteVector OrBytes( ByteVector a, ByteVector b )
+    { return _mm256_or_si256( a, b ); }
+static inline uint32 ByteMask( ByteVector v )
+    { return static_cast<uint32>( _mm256_movemask_epi8( v ) ); }
+
+#else
+
+typedef __m128i ByteVector;
+static const std::size_t BYTE_VECTOR_SIZE = 16;
+static const uint32 BYTE_VECTOR_ALL = 0xFFFF;
+static const uint32 BYTE_VECTOR_WORD_ENDS = 0x8888; // byte 3 of each 4-byte word
+
+static inline ByteVector LoadByteVector( const char *p )
+    { return _mm_loadu_si128( reinterpret_cast<const __m128i*>(p) ); }
+static inline ByteVector EqualBytes( ByteVector v, char c )
+    { return _mm_cmpeq_epi8( v, _mm_set1_epi8( c ) ); }
+static inline ByteVector OrBytes( ByteVector a, ByteVector b )
+    { return _mm_or_si128( a, b ); }
+static inline uint32 ByteMask( ByteVector v )
+    { return static_cast<uint32>( _mm_movemask_epi8( v ) ); }
+
+#endif
+
+
+static inline unsigned int LowestSetBit( uint32 x )
+{
+#if defined(__GNUC__)
+    return static_cast<unsigned int>( __builtin_ctz( x ) );
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward( &index, x );
+    return static_cast<unsigned int>( index );
+#else
+    unsigned int i = 0;
+    while( !(x & 1) ){
+        x >>= 1;
+        ++i;
+    }
+    return i;
+#endif
+}
+
+
+static inline unsigned int CountSetBits( uint32 x )
+{
+#if defined(__GNUC__)
+    return static_cast<unsigned int>( __builtin_popcount( x ) );
+#else
+    x = x - ((x >> 1) & 0x55555555);
+    x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+    return static_cast<unsigned int>( (((x + (x >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24 );
+#endif
+}
+
+
+// advance typeTag and argument over the run of fixed size, non-array type
+// tags (ifcrmhtdTFNI) starting at typeTag, a vector at a time, as long as
+// their arguments fit before end. anything else, including the terminating
+// '\0' and any run whose arguments would overrun the message, is left for
+// the scalar code to validate and report.
+static inline void SkipFixedSizeArguments( const char *&typeTag, const char *&argument, const char *end )
+{
+    // don't pay for a vector compare when the run is empty, as it is for
+    // every tag of a message made of strings or blobs
+    char first = *typeTag;
+    if( first == STRING_TYPE_TAG || first == SYMBOL_TYPE_TAG || first == BLOB_TYPE_TAG )
+        return;
+
+    while( static_cast<std::size_t>(end - typeTag) >= BYTE_VECTOR_SIZE ){
+        ByteVector tags = LoadByteVector( typeTag );
+
+        ByteVector size4 = OrBytes( OrBytes( EqualBytes( tags, INT32_TYPE_TAG ), EqualBytes( tags, FLOAT_TYPE_TAG ) ),
+                OrBytes( OrBytes( EqualBytes( tags, CHAR_TYPE_TAG ), EqualBytes( tags, RGBA_COLOR_TYPE_TAG ) ),
+                        EqualBytes( tags, MIDI_MESSAGE_TYPE_TAG ) ) );
+        ByteVector size8 = OrBytes( OrBytes( EqualBytes( tags, INT64_TYPE_TAG ), EqualBytes( tags, TIME_TAG_TYPE_TAG ) ),
+                EqualBytes( tags, DOUBLE_TYPE_TAG ) );
+        ByteVector size0 = OrBytes( OrBytes( EqualBytes( tags, TRUE_TYPE_TAG ), EqualBytes( tags, FALSE_TYPE_TAG ) ),
+                OrBytes( EqualBytes( tags, NIL_TYPE_TAG ), EqualBytes( tags, INFINITUM_TYPE_TAG ) ) );
+
+        uint32 mask4 = ByteMask( size4 );
+        uint32 mask8 = ByteMask( size8 );
+        uint32 fixed = mask4 | mask8 | ByteMask( size0 );
+
+        // only the tags before the first variable size one can be skipped
+        std::size_t runLength = BYTE_VECTOR_SIZE;
+        if( fixed != BYTE_VECTOR_ALL ){
+            runLength = LowestSetBit( ~fixed );
+            if( runLength == 0 )
+                return;
+            uint32 run = (static_cast<uint32>(1) << runLength) - 1;
+            mask4 &= run;
+            mask8 &= run;
+        }
+
+        std::size_t argumentsSize = 4 * CountSetBits( mask4 ) + 8 * CountSetBits( mask8 );
+        if( argumentsSize > static_cast<std::size_t>(end - argument) )
+            return;
+
+        typeTag += runLength;
+        argument += argumentsSize;
+
+        if( runLength != BYTE_VECTOR_SIZE )
+            return;
+    }
+}
+
+#endif /* OSC_VALIDATE_AVX2 || OSC_VALIDATE_SSE2 */
+
+
+
 // return the first 4 byte boundary after the end of a str4
 // be careful about calling this version if you don't know whether
 // the string is terminated correctly.
@@ -70,6 +214,21 @@ static inline const char* FindStr4End( const char *p, const char *end )
 	if( p[0] == '\0' )    // special case for SuperCollider integer address pattern
 		return p + 4;
 
+#if defined(OSC_VALIDATE_AVX2) || defined(OSC_VALIDATE_SSE2)
+    // look for the first word ending in '\0' a vector at a time. p stays
+    // 4-byte aligned relative to end, so the scalar tail below sees the same
+    // words it would have
+    while( static_cast<std::size_t>(end - p) >= BYTE_VECTOR_SIZE ){
+        uint32 mask = ByteMask( EqualBytes( LoadByteVector( p ), '\0' ) ) & BYTE_VECTOR_WORD_ENDS;
+        if( mask )
+            return p + LowestSetBit( mask ) + 1;
+        p += BYTE_VECTOR_SIZE;
+    }
+
+    if( p >= end )
+        return 0;
+#endif
+
     p += 3;
     end -= 1;
 
@@ -556,6 +715,31 @@ void ReceivedMessageArgumentIterator::Advance()
 
 //------------------------------------------------------------------------------
 
+void ReceivedMessageArgumentStream::Read32BitArray( void *values, std::size_t count, char typeTag )
+{
+    const char *typeTags = p_->typeTagPtr_;
+    std::size_t available = end_->typeTagPtr_ - typeTags;
+    std::size_t checked = ( count < available ) ? count : available;
+
+    // report a wrong type before a missing argument, as the one at a time
+    // extractors would
+    for( std::size_t i=0; i < checked; ++i ){
+        if( typeTags[i] != typeTag )
+            throw WrongArgumentTypeException();
+    }
+    if( checked < count )
+        throw MissingArgumentException();
+
+    // all of the arguments have already been validated in
+    // ReceivedMessage::Init(), and 32 bit arguments are stored contiguously
+    const char *arguments = p_->argumentPtr_;
+    CopySwapped32( static_cast<char*>(values), arguments, count );
+
+    p_ = ReceivedMessageArgumentIterator( typeTags + count, arguments + count * 4 );
+}
+
+//------------------------------------------------------------------------------
+
 ReceivedMessage::ReceivedMessage( const ReceivedPacket& packet )
     : addressPattern_( packet.Contents() )
 {
@@ -632,6 +816,11 @@ void ReceivedMessage::Init( const char *message, osc_bundle_element_size_t size
             unsigned int arrayLevel = 0;
                         
             do{
+#if defined(OSC_VALIDATE_AVX2) || defined(OSC_VALIDATE_SSE2)
+                SkipFixedSizeArguments( typeTag, argument, end );
+                if( *typeTag == '\0' )
+                    break;
+#endif
                 switch( *typeTag ){
                     case TRUE_TYPE_TAG:
                     case FALSE_TYPE_TAG:
@@ -690,13 +879,14 @@ void ReceivedMessage::Init( const char *message, osc_bundle_element_size_t size
                     case BLOB_TYPE_TAG:
                         {
                             if( argument + osc::OSC_SIZEOF_INT32 > end )
-                                MalformedMessageException( "arguments exceed message size" );
+                                throw MalformedMessageException( "arguments exceed message size" );
                                 
                             // treat blob size as an unsigned int for the purposes of this calculation
                             uint32 blobSize = ToUInt32( argument );
-                            argument = argument + osc::OSC_SIZEOF_INT32 + RoundUp4( blobSize );
-                            if( argument > end )
-                                MalformedMessageException( "arguments exceed message size" );
+                            argument = argument + osc::OSC_SIZEOF_INT32;
+                            if( RoundUp4( blobSize ) > static_cast<std::size_t>(end - argument) )
+                                throw MalformedMessageException( "arguments exceed message size" );
+                            argument += RoundUp4( blobSize );
                         }
                         break;
                         
@@ -213,6 +213,7 @@ public:
 		, argumentPtr_( argumentPtr ) {}
 
     friend class ReceivedMessageArgumentIterator;
+    friend class ReceivedMessageArgumentStream;
     
 	char TypeTag() const { return *typeTagPtr_; }
 
@@ -341,6 +342,8 @@ class ReceivedMessageArgumentStream{
         , end_( end ) {}
 
     ReceivedMessageArgumentIterator p_, end_;
+
+    void Read32BitArray( void *values, std::size_t count, char typeTag );
     
 public:
 
@@ -468,6 +471,21 @@ public:
 
         return *this;
     }
+
+    // extract count consecutive int32 or float arguments in one step. throws
+    // the same exceptions as extracting the values one at a time, but if an
+    // exception is thrown nothing is extracted and the stream isn't advanced.
+    ReceivedMessageArgumentStream& ReadInt32Array( int32 *values, std::size_t count )
+    {
+        Read32BitArray( values, count, INT32_TYPE_TAG );
+        return *this;
+    }
+
+    ReceivedMessageArgumentStream& ReadFloatArray( float *values, std::size_t count )
+    {
+        Read32BitArray( values, count, FLOAT_TYPE_TAG );
+        return *this;
+    }
 };
 
 
@@ -521,6 +539,10 @@ public:
 
     uint64 TimeTag() const;
 
+    // the whole bundle, starting with "#bundle"
+    const char *Contents() const { return timeTag_ - 8; }
+    osc_bundle_element_size_t Size() const { return (osc_bundle_element_size_t)(end_ - (timeTag_ - 8)); }
+
     uint32 ElementCount() const { return elementCount_; }
 
     typedef ReceivedBundleElementIterator const_iterator;
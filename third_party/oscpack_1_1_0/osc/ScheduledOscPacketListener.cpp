@@ -0,0 +1,187 @@
+/*
+	oscpack -- Open Sound Control (OSC) packet manipulation library
+    http://www.rossbencina.com/code/oscpack
+
+    Copyright (c) 2004-2013 Ross Bencina <rossb@audiomulch.com>
+
+	Permission is hereby granted, free of charge, to any person obtaining
+	a copy of this software and associated documentation files
+	(the "Software"), to deal in the Software without restriction,
+	including without limitation the rights to use, copy, modify, merge,
+	publish, distribute, sublicense, and/or sell copies of the Software,
+	and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+	MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+	IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+	ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+	WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+/*
+	The text above constitutes the entire oscpack license; however, 
+	the oscpack developer(s) also make the following non-binding requests:
+
+	Any person wishing to distribute modifications to the Software is
+	requested to send the modifications to the original developer so that
+	they can be incorporated into the canonical version. It is also 
+	requested that these non-binding requests be included whenever the
+	above license is reproduced.
+*/
+#include "ScheduledOscPacketListener.h"
+
+#if defined(__WIN32__) || defined(WIN32) || defined(_WIN32)
+#include <windows.h> // GetSystemTimeAsFileTime
+#else
+#include <sys/time.h> // gettimeofday
+#endif
+
+#include <algorithm>
+
+
+namespace osc{
+
+// seconds from the NTP epoch (1900) to the unix epoch (1970)
+static const uint64 NTP_UNIX_EPOCH_OFFSET = 2208988800UL;
+
+
+static void ValidateBundleContents( const ReceivedBundle& b )
+{
+    for( ReceivedBundle::const_iterator i = b.ElementsBegin(); i != b.ElementsEnd(); ++i ){
+        if( i->IsBundle() )
+            ValidateBundleContents( ReceivedBundle(*i) );
+        else
+            ReceivedMessage m(*i); // throws if malformed
+    }
+}
+
+
+ScheduledOscPacketListener::ScheduledOscPacketListener()
+    : nextSequence_( 0 )
+{
+}
+
+
+void ScheduledOscPacketListener::Schedule( const ReceivedBundle& b, const IpEndpointName& remoteEndpoint )
+{
+    ValidateBundleContents( b );
+
+    std::size_t slot;
+    if( freeSlots_.empty() ){
+        storage_.push_back( std::vector<char>() );
+        slot = storage_.size() - 1;
+    }else{
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    }
+
+    try{
+        storage_[slot].assign( b.Contents(), b.Contents() + b.Size() );
+
+        ScheduledBundle scheduled;
+        scheduled.timeTag = b.TimeTag();
+        scheduled.sequence = nextSequence_++;
+        scheduled.slot = slot;
+        scheduled.remoteEndpoint = remoteEndpoint;
+
+        queue_.push_back( scheduled );
+    }catch(...){
+        freeSlots_.push_back( slot );
+        throw;
+    }
+    std::push_heap( queue_.begin(), queue_.end(), IsLater );
+}
+
+
+void ScheduledOscPacketListener::DispatchElements( const ReceivedBundle& b, const IpEndpointName& remoteEndpoint )
+{
+    for( ReceivedBundle::const_iterator i = b.ElementsBegin(); i != b.ElementsEnd(); ++i ){
+        if( i->IsBundle() )
+            ProcessBundle( ReceivedBundle(*i), remoteEndpoint );
+        else
+            ProcessMessage( ReceivedMessage(*i), remoteEndpoint );
+    }
+}
+
+
+void ScheduledOscPacketListener::ProcessBundle( const ReceivedBundle& b, const IpEndpointName& remoteEndpoint )
+{
+    uint64 timeTag = b.TimeTag();
+    if( timeTag == 1 ){ // immediately
+        DispatchElements( b, remoteEndpoint );
+        return;
+    }
+
+    uint64 now = CurrentTimeTag();
+    if( timeTag > now ){
+        Schedule( b, remoteEndpoint );
+        return;
+    }
+
+    BundleDispatched( timeTag, TimeTagDifferenceNanoseconds( timeTag, now ) );
+    DispatchElements( b, remoteEndpoint );
+}
+
+
+void ScheduledOscPacketListener::TimerExpired()
+{
+    uint64 now = CurrentTimeTag();
+    while( !queue_.empty() && queue_.front().timeTag <= now ){
+        ScheduledBundle due = queue_.front();
+        std::pop_heap( queue_.begin(), queue_.end(), IsLater );
+        queue_.pop_back();
+
+        // the slot is only freed once the bundle has been dispatched, since
+        // dispatching it may schedule its nested bundles into other slots
+        const std::vector<char>& bundle = storage_[due.slot];
+        try{
+            ProcessBundle( ReceivedBundle( ReceivedPacket( &bundle[0], (osc_bundle_element_size_t)bundle.size() ) ),
+                    due.remoteEndpoint );
+        }catch(...){
+            freeSlots_.push_back( due.slot );
+            throw;
+        }
+        freeSlots_.push_back( due.slot );
+    }
+}
+
+
+uint64 ScheduledOscPacketListener::CurrentTimeTag()
+{
+    uint64 seconds, fraction;
+
+#if defined(__WIN32__) || defined(WIN32) || defined(_WIN32)
+    // 100 nanosecond intervals since 1601, which is 9435484800 seconds after the NTP epoch
+    FILETIME fileTime;
+    GetSystemTimeAsFileTime( &fileTime );
+    uint64 intervals = ((uint64)fileTime.dwHighDateTime << 32) | fileTime.dwLowDateTime;
+    seconds = intervals / 10000000 - 9435484800ULL;
+    fraction = ((intervals % 10000000) << 32) / 10000000;
+#else
+    struct timeval t;
+    gettimeofday( &t, 0 );
+    seconds = (uint64)t.tv_sec + NTP_UNIX_EPOCH_OFFSET;
+    fraction = ((uint64)t.tv_usec << 32) / 1000000;
+#endif
+
+    return (seconds << 32) | fraction;
+}
+
+
+int64 ScheduledOscPacketListener::TimeTagDifferenceNanoseconds( uint64 from, uint64 to )
+{
+    // time tags are 32.32 fixed point seconds
+    bool negative = to < from;
+    uint64 difference = negative ? from - to : to - from;
+    uint64 nanoseconds = (difference >> 32) * 1000000000
+            + (((difference & 0xFFFFFFFFUL) * 1000000000) >> 32);
+    return negative ? -(int64)nanoseconds : (int64)nanoseconds;
+}
+
+} // namespace osc
@@ -0,0 +1,126 @@
+/*
+	oscpack -- Open Sound Control (OSC) packet manipulation library
+    http://www.rossbencina.com/code/oscpack
+
+    Copyright (c) 2004-2013 Ross Bencina <rossb@audiomulch.com>
+
+	Permission is hereby granted, free of charge, to any person obtaining
+	a copy of this software and associated documentation files
+	(the "Software"), to deal in the Software without restriction,
+	including without limitation the rights to use, copy, modify, merge,
+	publish, distribute, sublicense, and/or sell copies of the Software,
+	and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be
+	included in all copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+	MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+	IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR
+	ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+	CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+	WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+/*
+	The text above constitutes the entire oscpack license; however, 
+	the oscpack developer(s) also make the following non-binding requests:
+
+	Any person wishing to distribute modifications to the Software is
+	requested to send the modifications to the original developer so that
+	they can be incorporated into the canonical version. It is also 
+	requested that these non-binding requests be included whenever the
+	above license is reproduced.
+*/
+#ifndef INCLUDED_OSCPACK_SCHEDULEDOSCPACKETLISTENER_H
+#define INCLUDED_OSCPACK_SCHEDULEDOSCPACKETLISTENER_H
+
+#include <deque>
+#include <vector>
+
+#include "OscPacketListener.h"
+#include "../ip/IpEndpointName.h"
+#include "../ip/TimerListener.h"
+
+
+namespace osc{
+
+// An OscPacketListener that holds each bundle until its time tag is due
+// instead of dispatching it on arrival. Attach it to a multiplexer both as
+// the socket's packet listener and as a periodic timer listener:
+//
+//     multiplexer.AttachSocketListener( &socket, &listener );
+//     multiplexer.AttachPeriodicTimerListener( 1, &listener );
+//
+// Pending bundles are copied into a priority queue keyed on time tag. Each
+// timer tick dispatches every bundle that has fallen due, earliest first
+// and in order of arrival for equal time tags, so the timer period bounds
+// how late a bundle is dispatched. Messages, bundles tagged immediate and
+// bundles whose time has already passed are dispatched on arrival. A
+// nested bundle due later than the bundle containing it is scheduled
+// again for its own time tag.
+//
+// Bundles are validated on arrival, so a malformed bundle throws from
+// ProcessPacket() as it would without scheduling, never from a timer tick.
+
+class ScheduledOscPacketListener : public OscPacketListener, public TimerListener{
+    struct ScheduledBundle{
+        uint64 timeTag;
+        uint64 sequence; // arrival order, to keep equal time tags in order
+        std::size_t slot; // index into storage_
+        IpEndpointName remoteEndpoint;
+    };
+
+    static bool IsLater( const ScheduledBundle& lhs, const ScheduledBundle& rhs )
+    {
+        return lhs.timeTag > rhs.timeTag
+                || (lhs.timeTag == rhs.timeTag && lhs.sequence > rhs.sequence);
+    }
+
+    // min-heap ordered by IsLater, so the next bundle due is front()
+    std::vector< ScheduledBundle > queue_;
+    // copies of the pending bundles. a deque never moves its elements, and
+    // released slots keep their capacity for the next bundle
+    std::deque< std::vector<char> > storage_;
+    std::vector< std::size_t > freeSlots_;
+    uint64 nextSequence_;
+
+    void Schedule( const ReceivedBundle& b, const IpEndpointName& remoteEndpoint );
+    void DispatchElements( const ReceivedBundle& b, const IpEndpointName& remoteEndpoint );
+
+protected:
+    // Schedules b, or dispatches it now if it is due.
+    virtual void ProcessBundle( const ReceivedBundle& b, const IpEndpointName& remoteEndpoint );
+
+    // Called before the elements of a bundle with a time tag are
+    // dispatched. latenessNanoseconds is how long after its time tag the
+    // bundle is dispatched: up to one timer period for a bundle that was
+    // scheduled, more for one that arrived late.
+    virtual void BundleDispatched( uint64 timeTag, int64 latenessNanoseconds )
+    {
+        (void) timeTag;
+        (void) latenessNanoseconds;
+    }
+
+    // The current time as an NTP time tag. Defaults to the system clock;
+    // override to follow another clock.
+    virtual uint64 CurrentTimeTag();
+
+public:
+    ScheduledOscPacketListener();
+
+    std::size_t PendingBundleCount() const { return queue_.size(); }
+
+    // Dispatches every pending bundle that is due.
+    virtual void TimerExpired();
+
+    // Nanoseconds from time tag 'from' to time tag 'to', negative if 'to'
+    // is earlier.
+    static int64 TimeTagDifferenceNanoseconds( uint64 from, uint64 to );
+};
+
+} // namespace osc
+
+#endif /* INCLUDED_OSCPACK_SCHEDULEDOSCPACKETLISTENER_H */
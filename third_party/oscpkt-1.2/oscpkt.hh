@@ -71,6 +71,7 @@ namespace oscpkt {
 #include <string>
 #include <vector>
 #include <list>
+#include <algorithm>
 
 #if defined(OSCPKT_OSTREAM_OUTPUT) || defined(OSCPKT_TEST)
 #include <iostream>
@@ -149,11 +150,28 @@ template <typename POD> void pod2bytes(const POD value, char *bytes) {
   }
 }
 
-/** internal stuff, handles the dynamic storage with correct alignments to 4 bytes */
+/** internal stuff, handles the dynamic storage with correct alignments to 4 bytes.
+    When given a caller supplied buffer it never grows: getBytes() returns 0 once
+    the buffer is full, and size() keeps counting the bytes that were requested. */
 struct Storage {
   std::vector<char> data;
-  Storage() { data.reserve(200); }
+  char *ext_data;
+  size_t ext_capacity, ext_size;
+  Storage() : ext_data(0), ext_capacity(0), ext_size(0) { data.reserve(200); }
+  Storage(char *buffer, size_t capacity) : ext_data(buffer), ext_capacity(capacity), ext_size(0) {}
+  void useBuffer(char *buffer, size_t capacity) { 
+    std::vector<char>().swap(data);
+    ext_data = buffer; ext_capacity = capacity; ext_size = 0; 
+  }
+  bool overflowed() const { return ext_data && ext_size > ext_capacity; }
   char *getBytes(size_t sz) {
+    if (ext_data) {
+      size_t sz4 = ceil4(sz), pos = ext_size;
+      ext_size += sz4;
+      if (overflowed()) return 0;
+      memset(ext_data + pos + sz, 0, sz4 - sz); // the zero padding
+      return ext_data + pos;
+    }
     assert((data.size() & 3) == 0);
     if (data.size() + sz > data.capacity()) { data.reserve((data.size() + sz)*2); }
     size_t sz4 = ceil4(sz);
@@ -161,13 +179,18 @@ struct Storage {
     data.resize(pos + sz4); // resize will fill with zeros, so the zero padding is OK
     return &(data[pos]);
   }
-  char *begin() { return data.size() ? &data.front() : 0; }
+  char *begin() { return ext_data ? ext_data : data.size() ? &data.front() : 0; }
   char *end() { return begin() + size(); }
-  const char *begin() const { return data.size() ? &data.front() : 0; }
+  const char *begin() const { return ext_data ? ext_data : data.size() ? &data.front() : 0; }
   const char *end() const { return begin() + size(); }
-  size_t size() const { return data.size(); }
-  void assign(const char *beg, const char *end) { data.assign(beg, end); }
-  void clear() { data.resize(0); }
+  size_t size() const { return ext_data ? ext_size : data.size(); }
+  void assign(const char *beg, const char *end) { 
+    if (ext_data) {
+      ext_size = end - beg;
+      if (!overflowed() && ext_size) memcpy(ext_data, beg, ext_size);
+    } else data.assign(beg, end); 
+  }
+  void clear() { if (ext_data) ext_size = 0; else data.resize(0); }
 };
 
 /** check if the path matches the supplied path pattern , according to the OSC spec pattern 
@@ -175,6 +198,8 @@ struct Storage {
 bool fullPatternMatch(const std::string &pattern, const std::string &path);
 /** check if the path matches the beginning of pattern */
 bool partialPatternMatch(const std::string &pattern, const std::string &path);
+inline const char *internalPatternMatch(const char *pattern, const char *path);
+class CompiledPattern;
 
 #if defined(OSCPKT_DEBUG)
 #define OSCPKT_SET_ERR(errcode) do { if (!err) { err = errcode; std::cerr << "set " #errcode << " at line " << __LINE__ << "\n"; } } while (0)
@@ -188,7 +213,9 @@ typedef enum { OK_NO_ERROR=0,
                // errors raised by ArgReader
                TYPE_MISMATCH, NOT_ENOUGH_ARG, PATTERN_MISMATCH, 
                // errors raised by PacketReader/PacketWriter
-               INVALID_BUNDLE, INVALID_PACKET_SIZE, BUNDLE_REQUIRED_FOR_MULTI_MESSAGES } ErrorCode;
+               INVALID_BUNDLE, INVALID_PACKET_SIZE, BUNDLE_REQUIRED_FOR_MULTI_MESSAGES,
+               // raised by a Message or PacketWriter whose caller supplied buffer is too small
+               BUFFER_OVERFLOW } ErrorCode;
 
 /**
    struct used to hold an OSC message that will be written or read.
@@ -325,6 +352,16 @@ public:
   bool isOk() const { return err == OK_NO_ERROR; }
   ErrorCode getErr() const { return err; }
 
+  /** store the arguments in the caller's buffer of 'capacity' bytes
+      from now on, instead of a vector that grows on demand. Arguments
+      that do not fit raise BUFFER_OVERFLOW. The buffer must outlive the
+      message and its copies, which share it. Clears the message. */
+  Message &useBuffer(void *buffer, size_t capacity) {
+    storage.useBuffer((char*)buffer, capacity);
+    clear();
+    return *this;
+  }
+
   /** return the type_tags string, with its initial ',' stripped. */
   const std::string &typeTags() const { return type_tags; }
   /** retrieve the address pattern. If you want to follow to the whole OSC spec, you
@@ -339,6 +376,13 @@ public:
     if (address.empty() || address[0] != '/') OSCPKT_SET_ERR(MALFORMED_ADDRESS_PATTERN);     
     return *this;
   }
+  /** same as init(std::string), reusing the address storage of a recycled message */
+  Message &init(const char *addr, TimeTag tt = TimeTag::immediate()) {
+    clear();
+    address.assign(addr); time_tag = tt;
+    if (address.empty() || address[0] != '/') OSCPKT_SET_ERR(MALFORMED_ADDRESS_PATTERN);     
+    return *this;
+  }
 
   /** start a matching test. The typical use-case is to follow this by
       a sequence of calls to popXXX() and a final call to
@@ -351,12 +395,16 @@ public:
       @endcode
   */
   ArgReader match(const std::string &test) const {
-    return ArgReader(*this, fullPatternMatch(address.c_str(), test.c_str()) ? OK_NO_ERROR : PATTERN_MISMATCH);
+    const char *q = internalPatternMatch(address.c_str(), test.c_str());
+    return ArgReader(*this, q && *q == 0 ? OK_NO_ERROR : PATTERN_MISMATCH);
   }
+  /** same as match(), with the roles swapped: the handler side holds a
+      pattern compiled once, and addressPattern() is matched as a plain path. */
+  ArgReader match(const CompiledPattern &pattern) const;
   /** return true if the 'test' path matched by the first characters of addressPattern().
       For ex. ("/foo/bar").partialMatch("/foo/") is true */
   ArgReader partialMatch(const std::string &test) const {
-    return ArgReader(*this, partialPatternMatch(address.c_str(), test.c_str()) ? OK_NO_ERROR : PATTERN_MISMATCH);
+    return ArgReader(*this, internalPatternMatch(address.c_str(), test.c_str()) ? OK_NO_ERROR : PATTERN_MISMATCH);
   }
   ArgReader arg() const { return ArgReader(*this, OK_NO_ERROR); }
 
@@ -364,6 +412,7 @@ public:
   void buildFromRawData(const void *ptr, size_t sz) {
     clear();
     storage.assign((const char*)ptr, (const char*)ptr + sz);
+    if (storage.overflowed()) { OSCPKT_SET_ERR(BUFFER_OVERFLOW); return; }
     const char *address_beg = storage.begin();
     const char *address_end = (const char*)memchr(address_beg, 0, storage.end()-address_beg);
     if (!address_end || !isZeroPaddingCorrect(address_end+1) || address_beg[0] != '/') { 
@@ -403,16 +452,28 @@ public:
     assert(s.size() < 2147483647); // insane values are not welcome
     type_tags += TYPE_TAG_STRING;
     arguments.push_back(std::make_pair(storage.size(), s.size() + 1));
-    strcpy(storage.getBytes(s.size()+1), s.c_str());
+    if (char *p = getBytes(s.size()+1)) strcpy(p, s.c_str());
+    return *this;
+  }
+  /** same as above without building a std::string, so that encoding into a caller
+      supplied buffer does not allocate for strings past the small string size */
+  Message &pushStr(const char *s) { return pushStr(s, strlen(s)); }
+  /** push the first num_bytes characters of s, which must not contain a 0 */
+  Message &pushStr(const char *s, size_t num_bytes) {
+    assert(num_bytes < 2147483647); // insane values are not welcome
+    type_tags += TYPE_TAG_STRING;
+    arguments.push_back(std::make_pair(storage.size(), num_bytes + 1));
+    if (char *p = getBytes(num_bytes+1)) { memcpy(p, s, num_bytes); p[num_bytes] = 0; }
     return *this;
   }
   Message &pushBlob(void *ptr, size_t num_bytes) {
     assert(num_bytes < 2147483647); // insane values are not welcome
     type_tags += TYPE_TAG_BLOB; 
     arguments.push_back(std::make_pair(storage.size(), num_bytes+4));
-    pod2bytes<int32_t>((int32_t)num_bytes, storage.getBytes(4));
-    if (num_bytes)
-      memcpy(storage.getBytes(num_bytes), ptr, num_bytes);
+    if (char *p = getBytes(4)) pod2bytes<int32_t>((int32_t)num_bytes, p);
+    if (num_bytes) {
+      if (char *p = getBytes(num_bytes)) memcpy(p, ptr, num_bytes);
+    }
     return *this;
   }
 
@@ -426,12 +487,13 @@ public:
   void packMessage(Storage &s, bool write_size) const {
     if (!isOk()) return;
     size_t l_addr = address.size()+1, l_type = type_tags.size()+2;
-    if (write_size) 
-      pod2bytes<uint32_t>(uint32_t(ceil4(l_addr) + ceil4(l_type) + ceil4(storage.size())), s.getBytes(4));
-    strcpy(s.getBytes(l_addr), address.c_str());
-    strcpy(s.getBytes(l_type), ("," + type_tags).c_str());
-    if (storage.size())
-      memcpy(s.getBytes(storage.size()), const_cast<Storage&>(storage).begin(), storage.size());
+    char *p;
+    if (write_size && (p = s.getBytes(4)) != 0)
+      pod2bytes<uint32_t>(uint32_t(ceil4(l_addr) + ceil4(l_type) + ceil4(storage.size())), p);
+    if ((p = s.getBytes(l_addr)) != 0) strcpy(p, address.c_str());
+    if ((p = s.getBytes(l_type)) != 0) { p[0] = ','; memcpy(p+1, type_tags.c_str(), l_type-1); }
+    if (storage.size() && (p = s.getBytes(storage.size())) != 0)
+      memcpy(p, storage.begin(), storage.size());
   }
 
 private:
@@ -472,10 +534,16 @@ private:
   template <typename POD> Message &pushPod(int tag, POD v) {
     type_tags += (char)tag; 
     arguments.push_back(std::make_pair(storage.size(), sizeof(POD)));
-    pod2bytes(v, storage.getBytes(sizeof(POD))); 
+    if (char *p = getBytes(sizeof(POD))) pod2bytes(v, p); 
     return *this;
   }
 
+  char *getBytes(size_t sz) {
+    char *p = storage.getBytes(sz);
+    if (!p) OSCPKT_SET_ERR(BUFFER_OVERFLOW);
+    return p;
+  }
+
 #ifdef OSCPKT_OSTREAM_OUTPUT
   friend std::ostream &operator<<(std::ostream &os, const Message &msg) {
     os << "osc_address: '" << msg.address << "', types: '" << msg.type_tags << "', timetag=" << msg.time_tag << ", args=[";
@@ -577,27 +645,39 @@ private:
 class PacketWriter {
 public:
   PacketWriter() { init(); }
+  /** encode straight into the caller's buffer of 'capacity' bytes
+      instead of an internal vector. The buffer is never grown: a packet
+      that does not fit raises BUFFER_OVERFLOW, and requiredSize() then
+      tells how large it would have been. Calling init() rewinds to the
+      start of the buffer, so reusing a writer costs no allocation. */
+  PacketWriter(void *buffer, size_t capacity) : storage((char*)buffer, capacity) { init(); }
   PacketWriter &init() { err = OK_NO_ERROR; storage.clear(); bundles.clear(); return *this; }
+  /** switch to the caller's buffer, see PacketWriter(buffer, capacity) */
+  PacketWriter &init(void *buffer, size_t capacity) { storage.useBuffer((char*)buffer, capacity); return init(); }
   
   /** begin a new bundle. If you plan to pack more than one message in the Osc packet, you have to 
       put them in a bundle. Nested bundles inside bundles are also allowed. */
   PacketWriter &startBundle(TimeTag ts = TimeTag::immediate()) {
     char *p;
     if (bundles.size()) storage.getBytes(4); // hold the bundle size
-    p = storage.getBytes(8); strcpy(p, "#bundle"); bundles.push_back(p - storage.begin());
-    p = storage.getBytes(8); pod2bytes<uint64_t>(ts, p);
+    bundles.push_back(storage.size());
+    if ((p = storage.getBytes(8)) != 0) strcpy(p, "#bundle"); 
+    if ((p = storage.getBytes(8)) != 0) pod2bytes<uint64_t>(ts, p);
+    checkOverflow();
     return *this;
   }
   /** close the current bundle. */
   PacketWriter &endBundle() {
     if (bundles.size()) {
       if (storage.size() - bundles.back() == 16) {
-        pod2bytes<uint32_t>(0, storage.getBytes(4)); // the 'empty bundle' case, not very elegant
+        char *p = storage.getBytes(4); // the 'empty bundle' case, not very elegant
+        if (p) pod2bytes<uint32_t>(0, p); 
       }
-      if (bundles.size()>1) { // no size stored for the top-level bundle
+      if (bundles.size()>1 && !storage.overflowed()) { // no size stored for the top-level bundle
         pod2bytes<uint32_t>(uint32_t(storage.size() - bundles.back()), storage.begin() + bundles.back()-4);
       }
       bundles.pop_back();      
+      checkOverflow();
     } else OSCPKT_SET_ERR(INVALID_BUNDLE);
     return *this;
   }
@@ -608,6 +688,7 @@ public:
     if (storage.size() != 0 && bundles.empty()) OSCPKT_SET_ERR(BUNDLE_REQUIRED_FOR_MULTI_MESSAGES);
     else msg.packMessage(storage, bundles.size()>0);
     if (!msg.isOk()) OSCPKT_SET_ERR(msg.getErr());
+    checkOverflow();
     return *this;
   }
 
@@ -623,10 +704,15 @@ public:
   
   /** return the bytes of the osc packet (NULL if the construction of the packet has failed) */
   char *packetData() { return err ? 0 : storage.begin(); }
+
+  /** the number of bytes the packet needs, even when it overflowed a caller supplied buffer */
+  size_t requiredSize() const { return storage.size(); }
 private:  
   std::vector<size_t> bundles; // hold the position in the storage array of the beginning marker of each bundle
   Storage storage;
   ErrorCode err;
+
+  void checkOverflow() { if (storage.overflowed()) OSCPKT_SET_ERR(BUFFER_OVERFLOW); }
 };
 
 // see the OSC spec for the precise pattern matching rules
@@ -696,6 +782,529 @@ inline bool fullPatternMatch(const std::string &pattern, const std::string &test
   return q && *q == 0;
 }
 
+/**
+   An address pattern parsed once into a sequence of operations (literal
+   runs, '?', bracketted classes as bitmaps, '*', '//' and braced lists)
+   so that it can be matched against many paths without re-interpreting
+   it each time. matches(path) gives exactly the result of
+   fullPatternMatch(pattern, path), including its handling of malformed
+   patterns and its first-match-wins choice inside braced lists.
+   @code
+   CompiledPattern pat("/mixer/ch/[0-9]/{gain,pan}");
+   if (pat.matches(msg.addressPattern())) { ... }
+   @endcode
+*/
+class CompiledPattern {
+public:
+  CompiledPattern() { compile(std::string()); }
+  explicit CompiledPattern(const std::string &pattern) { compile(pattern); }
+
+  void compile(const std::string &pattern) {
+    source = pattern; text.clear(); ops.clear(); alternatives.clear(); classes.clear();
+    min_length = 0; bounded = true;
+    const char *p = pattern.c_str();
+    while (*p) {
+      if (*p == '?') { addOp(ANY_CHAR, 0, 1); ++p; }
+      else if (*p == '[') { 
+        ++p;
+        bool reverse = false;
+        if (*p == '!') { reverse = true; ++p; }
+        size_t cls = classes.size(); classes.resize(cls + 8, 0);
+        for (; *p && *p != ']'; ++p) {
+          char c0 = *p, c1 = c0;
+          if (p[1] == '-' && p[2] && p[2] != ']') { p += 2; c1 = *p; }
+          for (int c = 1; c < 256; ++c) {
+            if ((char)c >= c0 && (char)c <= c1) classes[cls + c/32] |= 1u << (c%32);
+          }
+        }
+        if (*p != ']') { addOp(FAIL, 0, 0); return; }
+        if (reverse) { 
+          for (int i=0; i < 8; ++i) classes[cls + i] = ~classes[cls + i];
+          classes[cls] &= ~1u; // never matches the end of the path
+        }
+        addOp(CHAR_CLASS, cls, 1); ++p;
+      } else if (*p == '*') { 
+        while (*p == '*') ++p; 
+        addOp(STAR, 0, 0); bounded = false;
+      } else if (*p == '/' && p[1] == '/') { 
+        while (p[1] == '/') ++p; // the last '/' is matched as a literal
+        addOp(SUPER_WILDCARD, 0, 0); bounded = false;
+      } else if (*p == '{') {
+        const char *end = strchr(p, '}');
+        if (!end) { addOp(FAIL, 0, 0); return; }
+        size_t first = alternatives.size(), shortest = size_t(-1);
+        do {
+          ++p;
+          const char *q = strchr(p, ',');
+          if (q == 0 || q > end) q = end;
+          alternatives.push_back(std::make_pair(text.size(), size_t(q-p)));
+          text.append(p, q);
+          shortest = std::min(shortest, size_t(q-p));
+          p = q;
+        } while (p != end);
+        addOp(ALTERNATIVES, first, alternatives.size() - first);
+        min_length += shortest; bounded = false; ++p;
+      } else {
+        if (ops.empty() || ops.back().code != LITERAL) addOp(LITERAL, text.size(), 0);
+        text.push_back(*p); ++ops.back().len; ++min_length; ++p;
+      }
+    }
+  }
+
+  const std::string &pattern() const { return source; }
+  /** true when the pattern has no wildcard, in which case it only matches itself */
+  bool isLiteral() const { return ops.empty() || (ops.size() == 1 && ops[0].code == LITERAL); }
+  /** shortest path length that can match */
+  size_t minLength() const { return min_length; }
+  /** true when every match has exactly minLength() characters */
+  bool isFixedLength() const { return bounded; }
+  /** the characters every match starts with */
+  std::string literalPrefix() const { 
+    return !ops.empty() && ops[0].code == LITERAL ? text.substr(ops[0].arg, ops[0].len) : std::string(); 
+  }
+
+  bool matches(const char *path) const { return matchFrom(0, path); }
+  bool matches(const std::string &path) const { return matchFrom(0, path.c_str()); }
+
+private:
+  enum OpCode { LITERAL, ANY_CHAR, CHAR_CLASS, STAR, SUPER_WILDCARD, ALTERNATIVES, FAIL };
+  struct Op { 
+    OpCode code; 
+    size_t arg; // LITERAL: offset in text, CHAR_CLASS: offset in classes, ALTERNATIVES: first alternative
+    size_t len; // LITERAL: length, ALTERNATIVES: number of alternatives
+  };
+  std::string source;
+  std::string text;
+  std::vector<Op> ops;
+  std::vector<std::pair<size_t, size_t> > alternatives; // offset and length in text
+  std::vector<uint32_t> classes; // 256 bits per class
+  size_t min_length;
+  bool bounded;
+
+  void addOp(OpCode code, size_t arg, size_t len) { 
+    Op op; op.code = code; op.arg = arg; op.len = len; ops.push_back(op); 
+    if (code == CHAR_CLASS || code == ANY_CHAR) min_length += len;
+  }
+
+  bool matchFrom(size_t i, const char *path) const {
+    for (; i < ops.size(); ++i) {
+      const Op &op = ops[i];
+      switch (op.code) {
+        case LITERAL: {
+          /* the literal holds no '\0', so a shorter path fails before its end */
+          const char *lit = text.data() + op.arg;
+          for (size_t k=0; k < op.len; ++k) if (lit[k] != path[k]) return false;
+          path += op.len; break;
+        }
+        case ANY_CHAR:
+          if (!*path) return false;
+          ++path; break;
+        case CHAR_CLASS: {
+          unsigned char c = (unsigned char)*path;
+          if (!(classes[op.arg + c/32] & (1u << (c%32)))) return false;
+          ++path; break;
+        }
+        case STAR:
+          if (i + 1 == ops.size()) return strchr(path, '/') == 0;
+          while (true) {
+            if (matchFrom(i+1, path)) return true;
+            if (*path == 0 || *path == '/') return false;
+            ++path;
+          }
+        case SUPER_WILDCARD:
+          while (true) {
+            if (matchFrom(i+1, path)) return true;
+            if (*path == 0 || (path = strchr(path+1, '/')) == 0) return false;
+          }
+        case ALTERNATIVES: {
+          /* like internalPatternMatch, commit to the first alternative that matches */
+          size_t a = op.arg, a_end = op.arg + op.len;
+          while (a < a_end && strncmp(text.data() + alternatives[a].first, path, alternatives[a].second) != 0) ++a;
+          if (a == a_end) return false;
+          path += alternatives[a].second; break;
+        }
+        case FAIL:
+          return false;
+      }
+    }
+    return *path == 0;
+  }
+};
+
+inline Message::ArgReader Message::match(const CompiledPattern &pattern) const {
+  return ArgReader(*this, pattern.matches(address) ? OK_NO_ERROR : PATTERN_MISMATCH);
+}
+
+/**
+   A set of compiled patterns matched together against one path, for
+   routing a message to every handler whose pattern accepts it. Literal
+   patterns are found by binary search. The others are grouped by the
+   path segments their literal prefix spans (e.g. "/mixer/ch/" for
+   "/mixer/ch/1?/fader"), so only the groups of the path's own leading
+   segments are visited, and are filtered on length before being matched.
+*/
+class PatternSet {
+public:
+  /** compile and add a pattern, returning its index */
+  size_t add(const std::string &pattern) {
+    size_t index = patterns.size();
+    patterns.push_back(CompiledPattern(pattern));
+    if (patterns.back().isLiteral()) {
+      std::pair<std::string, size_t> entry(pattern, index);
+      literals.insert(std::upper_bound(literals.begin(), literals.end(), entry), entry);
+    } else {
+      std::string prefix = patterns.back().literalPrefix();
+      prefix.resize(prefix.rfind('/') == std::string::npos ? 0 : prefix.rfind('/') + 1);
+      std::pair<std::string, size_t> entry(prefix, index);
+      wildcards.insert(std::upper_bound(wildcards.begin(), wildcards.end(), entry), entry);
+    }
+    return index;
+  }
+  size_t size() const { return patterns.size(); }
+  const CompiledPattern &pattern(size_t index) const { return patterns[index]; }
+  void clear() { patterns.clear(); literals.clear(); wildcards.clear(); }
+
+  /** store in 'matches' the index of every pattern that fully matches
+      'path', in increasing order, and return how many there are. */
+  size_t matchAll(const char *path, std::vector<size_t> &matches) const {
+    matches.clear();
+    size_t path_len = strlen(path);
+    for (size_t i = findFirst(literals, path, path_len); 
+         i < literals.size() && literals[i].first.size() == path_len && literals[i].first == path; ++i) {
+      matches.push_back(literals[i].second);
+    }
+    /* visit the groups keyed "", then each prefix of path ending with a '/' */
+    for (size_t key_len = 0; key_len <= path_len; ++key_len) {
+      if (key_len && path[key_len-1] != '/') continue;
+      for (size_t i = findFirst(wildcards, path, key_len); 
+           i < wildcards.size() && wildcards[i].first.compare(0, std::string::npos, path, key_len) == 0; ++i) {
+        const CompiledPattern &pat = patterns[wildcards[i].second];
+        if (path_len < pat.minLength() || (pat.isFixedLength() && path_len != pat.minLength())) continue;
+        if (pat.matches(path)) matches.push_back(wildcards[i].second);
+      }
+    }
+    std::sort(matches.begin(), matches.end());
+    return matches.size();
+  }
+  size_t matchAll(const std::string &path, std::vector<size_t> &matches) const { return matchAll(path.c_str(), matches); }
+
+private:
+  std::vector<CompiledPattern> patterns;
+  std::vector<std::pair<std::string, size_t> > literals; // sorted
+  std::vector<std::pair<std::string, size_t> > wildcards; // keyed by literal prefix up to its last '/', sorted
+
+  /* index of the first entry whose key is not less than the first len characters of path */
+  static size_t findFirst(const std::vector<std::pair<std::string, size_t> > &entries, const char *path, size_t len) {
+    size_t lo = 0, hi = entries.size();
+    while (lo < hi) {
+      size_t mid = (lo + hi) / 2;
+      if (entries[mid].first.compare(0, std::string::npos, path, len) < 0) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+  }
+};
+
+/**
+   Non-owning counterpart of Message, handed out by PacketReaderView: the
+   address, type tags and arguments are read in place from the packet
+   bytes, which must outlive it, so nothing is copied or allocated. The
+   packet is validated exactly as Message::buildFromRawData does, with
+   the same error codes, and the ArgReader has the same popXXX() chain,
+   plus popStr / popBlob overloads that return pointers into the packet.
+*/
+class MessageView {
+  TimeTag time_tag;
+  const char *address;
+  const char *type_tags; // without the initial ','
+  size_t nb_args;
+  const char *args, *end;
+  ErrorCode err;
+public:
+  class ArgReader {
+    const MessageView *msg;
+    ErrorCode err;
+    size_t arg_idx; // arg index of the next arg that will be popped out.
+    const char *arg; // and its data
+  public:
+    ArgReader(const MessageView &m, ErrorCode e = OK_NO_ERROR) : msg(&m), err(msg->getErr()), arg_idx(0), arg(m.args) { 
+      if (e != OK_NO_ERROR && err == OK_NO_ERROR) err=e; 
+    }
+    bool isBool() { return currentTypeTag() == TYPE_TAG_TRUE || currentTypeTag() == TYPE_TAG_FALSE; }
+    bool isInt32() { return currentTypeTag() == TYPE_TAG_INT32; }
+    bool isInt64() { return currentTypeTag() == TYPE_TAG_INT64; }
+    bool isFloat() { return currentTypeTag() == TYPE_TAG_FLOAT; }
+    bool isDouble() { return currentTypeTag() == TYPE_TAG_DOUBLE; }
+    bool isStr() { return currentTypeTag() == TYPE_TAG_STRING; }
+    bool isBlob() { return currentTypeTag() == TYPE_TAG_BLOB; }
+
+    size_t nbArgRemaining() const { return msg->nb_args - arg_idx; }
+    bool isOk() const { return err == OK_NO_ERROR; }
+    operator bool() const { return isOk(); }
+    bool isOkNoMoreArgs() const { return err == OK_NO_ERROR && nbArgRemaining() == 0; }
+    ErrorCode getErr() const { return err; }
+
+    ArgReader &popInt32(int32_t &i) { return popPod<int32_t>(TYPE_TAG_INT32, i); }
+    ArgReader &popInt64(int64_t &i) { return popPod<int64_t>(TYPE_TAG_INT64, i); }
+    ArgReader &popFloat(float &f) { return popPod<float>(TYPE_TAG_FLOAT, f); }
+    ArgReader &popDouble(double &d) { return popPod<double>(TYPE_TAG_DOUBLE, d); }
+    /** retrieve a string argument as a pointer into the packet */
+    ArgReader &popStr(const char *&s) {
+      if (precheck(TYPE_TAG_STRING)) { s = arg; next(); }
+      return *this;
+    }
+    ArgReader &popStr(std::string &s) {
+      if (precheck(TYPE_TAG_STRING)) { s = arg; next(); }
+      return *this;
+    }
+    /** retrieve a binary blob as a pointer into the packet and its size */
+    ArgReader &popBlob(const void *&data, size_t &size) { 
+      if (precheck(TYPE_TAG_BLOB)) { data = arg + 4; size = argSize() - 4; next(); }
+      return *this;
+    }
+    ArgReader &popBlob(std::vector<char> &b) { 
+      if (precheck(TYPE_TAG_BLOB)) { b.assign(arg + 4, arg + argSize()); next(); }
+      return *this;
+    }
+    ArgReader &popBool(bool &b) {
+      b = false;
+      if (arg_idx >= msg->nb_args) OSCPKT_SET_ERR(NOT_ENOUGH_ARG); 
+      else if (currentTypeTag() == TYPE_TAG_TRUE) b = true;
+      else if (currentTypeTag() == TYPE_TAG_FALSE) b = false;
+      else OSCPKT_SET_ERR(TYPE_MISMATCH);
+      if (!err) next(); else ++arg_idx;
+      return *this;
+    }
+    ArgReader &pop() {
+      if (arg_idx >= msg->nb_args) OSCPKT_SET_ERR(NOT_ENOUGH_ARG); 
+      else if (!err) next(); else ++arg_idx;
+      return *this;
+    }
+  private:
+    int currentTypeTag() {
+      if (!err && arg_idx < msg->nb_args) return msg->type_tags[arg_idx];
+      else OSCPKT_SET_ERR(NOT_ENOUGH_ARG);
+      return -1;
+    }
+    /* the message was validated, so the sizes can be trusted */
+    size_t argSize() const { return MessageView::argSize(msg->type_tags[arg_idx], arg); }
+    void next() { arg += ceil4(argSize()); ++arg_idx; }
+    template <typename POD> ArgReader &popPod(int tag, POD &v) {
+      if (precheck(tag)) { v = bytes2pod<POD>(arg); next(); } 
+      else v = POD(0);
+      return *this;
+    }
+    bool precheck(int tag) { 
+      if (arg_idx >= msg->nb_args) OSCPKT_SET_ERR(NOT_ENOUGH_ARG); 
+      else if (!err && currentTypeTag() != tag) OSCPKT_SET_ERR(TYPE_MISMATCH);
+      return err == OK_NO_ERROR;
+    }
+  };
+
+  MessageView() : address(""), type_tags(""), nb_args(0), args(0), end(0), err(OK_NO_ERROR) {}
+  MessageView(const void *ptr, size_t sz, TimeTag tt = TimeTag::immediate()) { init(ptr, sz, tt); }
+
+  /** point the view at raw message data and validate it */
+  void init(const void *ptr, size_t sz, TimeTag tt = TimeTag::immediate()) { init(ptr, sz, tt, true); }
+
+  bool isOk() const { return err == OK_NO_ERROR; }
+  ErrorCode getErr() const { return err; }
+  /** the address pattern, null terminated in place */
+  const char *addressPattern() const { return address; }
+  /** the type tags, with the initial ',' stripped */
+  const char *typeTags() const { return type_tags; }
+  TimeTag timeTag() const { return time_tag; }
+
+  ArgReader match(const std::string &test) const {
+    const char *q = internalPatternMatch(address, test.c_str());
+    return ArgReader(*this, q && *q == 0 ? OK_NO_ERROR : PATTERN_MISMATCH);
+  }
+  ArgReader match(const CompiledPattern &pattern) const {
+    return ArgReader(*this, pattern.matches(address) ? OK_NO_ERROR : PATTERN_MISMATCH);
+  }
+  ArgReader partialMatch(const std::string &test) const {
+    return ArgReader(*this, internalPatternMatch(address, test.c_str()) ? OK_NO_ERROR : PATTERN_MISMATCH);
+  }
+  ArgReader arg() const { return ArgReader(*this, OK_NO_ERROR); }
+
+private:
+  friend class PacketReaderView;
+
+  /* with validate false, data already validated is only indexed */
+  void init(const void *ptr, size_t sz, TimeTag tt, bool validate) {
+    const char *beg = (const char*)ptr;
+    time_tag = tt; err = OK_NO_ERROR; end = beg + sz;
+    address = ""; type_tags = ""; nb_args = 0; args = end;
+
+    const char *address_end = sz ? (const char*)memchr(beg, 0, sz) : 0;
+    if (!address_end || !isPaddingCorrect(beg, address_end+1) || beg[0] != '/') {
+      OSCPKT_SET_ERR(MALFORMED_ADDRESS_PATTERN); return;
+    }
+    const char *type_tags_beg = beg + ceil4(size_t(address_end+1 - beg));
+    const char *type_tags_end = (const char*)memchr(type_tags_beg, 0, end-type_tags_beg);
+    if (!type_tags_end || !isPaddingCorrect(beg, type_tags_end+1) || type_tags_beg[0] != ',') { 
+      OSCPKT_SET_ERR(MALFORMED_TYPE_TAGS); return; 
+    }
+    address = beg; type_tags = type_tags_beg + 1; nb_args = type_tags_end - type_tags;
+    args = beg + ceil4(size_t(type_tags_end+1 - beg));
+    if (!validate) return;
+
+    const char *arg = args;
+    size_t iarg = 0;
+    while (isOk() && iarg < nb_args) {
+      size_t len = checkedArgSize(beg, type_tags[iarg], arg);
+      arg += ceil4(len); ++iarg;
+    }
+    if (iarg < nb_args || arg != end) {
+      OSCPKT_SET_ERR(MALFORMED_ARGUMENTS);
+    }
+  }
+
+  /* like isZeroPaddingCorrect, with the 4 byte boundaries counted from the start of the message, which is not
+     necessarily aligned in memory */
+  static bool isPaddingCorrect(const char *beg, const char *p) {
+    const char *q = beg + ceil4(size_t(p - beg));
+    for (; p < q; ++p) if (*p != 0) return false;
+    return true;
+  }
+
+  static size_t argSize(int type, const char *p) {
+    switch (type) {
+      case TYPE_TAG_INT32: 
+      case TYPE_TAG_FLOAT: return 4;
+      case TYPE_TAG_INT64: 
+      case TYPE_TAG_DOUBLE: return 8;
+      case TYPE_TAG_STRING: return strlen(p) + 1;
+      case TYPE_TAG_BLOB: return 4 + bytes2pod<uint32_t>(p);
+      default: return 0;
+    }
+  }
+
+  /* same checks as Message::getArgSize */
+  size_t checkedArgSize(const char *beg, int type, const char *p) {
+    size_t sz = 0;
+    switch (type) {
+      case TYPE_TAG_TRUE:
+      case TYPE_TAG_FALSE: sz = 0; break;
+      case TYPE_TAG_INT32: 
+      case TYPE_TAG_FLOAT: sz = 4; break;
+      case TYPE_TAG_INT64: 
+      case TYPE_TAG_DOUBLE: sz = 8; break;
+      case TYPE_TAG_STRING: {
+        const char *q = (const char*)memchr(p, 0, end-p);
+        if (!q) OSCPKT_SET_ERR(MALFORMED_ARGUMENTS);
+        else sz = (q-p)+1;
+      } break;
+      case TYPE_TAG_BLOB: {
+        if (p == end) { OSCPKT_SET_ERR(MALFORMED_ARGUMENTS); return 0; }
+        sz = 4+bytes2pod<uint32_t>(p);
+      } break;
+      default: {
+        OSCPKT_SET_ERR(UNHANDLED_TYPE_TAGS); return 0;
+      } break;
+    }
+    if (p+sz > end || p+sz < p) { 
+      OSCPKT_SET_ERR(MALFORMED_ARGUMENTS); return 0; 
+    }
+    if (!isPaddingCorrect(beg, p+sz)) { OSCPKT_SET_ERR(MALFORMED_ARGUMENTS); return 0; }
+    return sz;
+  }
+};
+
+/**
+   Allocation free alternative to PacketReader. init() validates the
+   whole packet up front, as PacketReader does, so popMessage() returns
+   nothing for a packet with any malformed message, and getErr() reports
+   the same error codes. Messages are then handed out one at a time as a
+   MessageView into the packet, which is only valid until the next
+   popMessage() or init() call.
+
+   Bundles may be nested up to MAX_BUNDLE_DEPTH levels; deeper packets
+   are rejected with INVALID_BUNDLE.
+*/
+class PacketReaderView {
+public:
+  enum { MAX_BUNDLE_DEPTH = 32 };
+
+  PacketReaderView() : depth(0), pending_message(0), pending_size(0), err(OK_NO_ERROR) {}
+  PacketReaderView(const void *ptr, size_t sz) { init(ptr, sz); }
+
+  void init(const void *ptr, size_t sz) {
+    const char *beg = (const char*)ptr;
+    err = OK_NO_ERROR; depth = 0; pending_message = 0; pending_size = 0;
+    if ((sz%4) == 0) { 
+      validate(beg, beg+sz, TimeTag::immediate(), 0);
+    } else OSCPKT_SET_ERR(INVALID_PACKET_SIZE);
+    if (err || sz == 0) return;
+    if (*beg == '#') pushBundle(beg, beg+sz);
+    else { pending_message = beg; pending_size = sz; }
+  }
+
+  /** the next message of the packet, or 0 when all have been read or the packet is invalid */
+  MessageView *popMessage() {
+    if (err) return 0;
+    if (pending_message) {
+      current.init(pending_message, pending_size, TimeTag::immediate(), false);
+      pending_message = 0;
+      return &current;
+    }
+    while (depth) {
+      Frame &f = frames[depth-1];
+      if (f.pos == f.end) { --depth; continue; }
+      uint32_t sz = bytes2pod<uint32_t>(f.pos);
+      const char *elem = f.pos + 4;
+      f.pos = elem + sz;
+      if (sz == 0) continue;
+      if (*elem == '#') pushBundle(elem, elem + sz);
+      else {
+        current.init(elem, sz, f.time_tag, false);
+        return &current;
+      }
+    }
+    return 0;
+  }
+  bool isOk() const { return err == OK_NO_ERROR; }
+  ErrorCode getErr() const { return err; }
+
+private:
+  struct Frame { const char *pos, *end; TimeTag time_tag; };
+  Frame frames[MAX_BUNDLE_DEPTH];
+  size_t depth;
+  const char *pending_message; // a packet holding a single message
+  size_t pending_size;
+  MessageView current;
+  ErrorCode err;
+
+  void pushBundle(const char *beg, const char *end) {
+    Frame f; f.pos = beg + 16; f.end = end; f.time_tag = TimeTag(bytes2pod<uint64_t>(beg+8));
+    frames[depth++] = f;
+  }
+
+  /* the checks of PacketReader::parse, without keeping the messages */
+  void validate(const char *beg, const char *end, TimeTag time_tag, size_t level) {
+    if (beg == end) return;
+    if (*beg == '#') {
+      if (end - beg >= 20 && memcmp(beg, "#bundle\0", 8) == 0 && level < MAX_BUNDLE_DEPTH) {
+        TimeTag time_tag2(bytes2pod<uint64_t>(beg+8));
+        const char *pos = beg + 16;
+        do {
+          uint32_t sz = bytes2pod<uint32_t>(pos); pos += 4;
+          if ((sz&3) != 0 || pos + sz > end || pos+sz < pos) {
+            OSCPKT_SET_ERR(INVALID_BUNDLE);
+          } else {
+            validate(pos, pos+sz, time_tag2, level+1);
+            pos += sz;
+          }
+        } while (!err && pos != end);
+      } else {
+        OSCPKT_SET_ERR(INVALID_BUNDLE);
+      }
+    } else {
+      MessageView message(beg, end-beg, time_tag);
+      if (!message.isOk()) OSCPKT_SET_ERR(message.getErr());
+    }
+  }
+};
+
 } // namespace oscpkt
 
 #endif // OSCPKT_HH
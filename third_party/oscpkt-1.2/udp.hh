@@ -46,6 +46,7 @@
 # include <netdb.h>
 # include <sys/time.h>
 #endif
+#include <algorithm>
 #include <cstring>
 #include <cstdio>
 #include <cstdlib>
@@ -54,6 +55,10 @@
 #include <string>
 #include <vector>
 
+#if defined(__linux__)
+# define OSCPKT_HAVE_MMSG
+#endif
+
 namespace oscpkt {
 
 /** a wrapper class for holding an ip address, mostly used internnally */
@@ -127,8 +132,25 @@ struct UdpSocket {
 
   std::vector<char> buffer;
 
+  /* storage for receiveNextPackets: batch_size slots of MAX_DATAGRAM_SIZE bytes */
+  enum { MAX_DATAGRAM_SIZE = 65536 };
+  std::vector<char> batch_buffer;
+  std::vector<size_t> batch_sizes;
+  std::vector<SockAddr> batch_origins;
+  int batch_size;
+
+  /* receive ring used by receiveNextPacket once enableReceiveRing was called */
+  std::vector<char> ring_buffer;
+  int ring_slot_count, ring_next_slot;
+  char *ring_packet;
+  size_t ring_packet_size;
+
+  /* packets waiting for flushQueuedPackets */
+  std::vector<char> send_queue;
+  std::vector<size_t> send_queue_sizes;
+
 
-  UdpSocket() : handle(-1) { 
+  UdpSocket() : handle(-1), batch_size(0), ring_slot_count(0), ring_next_slot(0), ring_packet(0), ring_packet_size(0) { 
 #ifdef WIN32
     WSADATA wsa_data;
     if (WSAStartup(MAKEWORD(2,2), &wsa_data) != 0) {
@@ -215,9 +237,18 @@ struct UdpSocket {
   */
   bool receiveNextPacket(int timeout_ms = -1) {
     if (!isOk() || handle == -1) { setErr("not opened.."); return false; }
-    /* 128k seems to be a reasonable value -- on linux, the max
-       datagram size appears to be a little bit less than 65536 */
-    buffer.resize(1024*128); 
+    char *dest; size_t capacity;
+    if (ring_slot_count) {
+      ring_packet = &ring_buffer[(size_t)ring_next_slot * MAX_DATAGRAM_SIZE];
+      ring_packet_size = 0;
+      ring_next_slot = (ring_next_slot + 1) % ring_slot_count;
+      dest = ring_packet; capacity = MAX_DATAGRAM_SIZE;
+    } else {
+      /* 128k seems to be a reasonable value -- on linux, the max
+         datagram size appears to be a little bit less than 65536 */
+      buffer.resize(1024*128); 
+      dest = &buffer[0]; capacity = buffer.size();
+    }
     
     /* check if something is available */
     if (timeout_ms >= 0) {
@@ -239,7 +270,7 @@ struct UdpSocket {
 
     /* now we should be able to read without blocking.. */
     socklen_t len = (socklen_t)remote_addr.maxLen();
-    int nread = (int)recvfrom(handle, &buffer[0], (int)buffer.size(), 0,
+    int nread = (int)recvfrom(handle, dest, (int)capacity, 0,
                               &remote_addr.addr(), &len);
     if (nread < 0) {       
       // maybe here we should differentiate EAGAIN/EINTR/EWOULDBLOCK from real errors
@@ -263,7 +294,10 @@ struct UdpSocket {
       if (!isOk()) close();
       return false;
     }
-    if (nread > (int)buffer.size()) {
+    if (ring_slot_count) {
+      /* a truncated datagram is dropped, as below */
+      ring_packet_size = nread > (int)capacity ? 0 : (size_t)nread;
+    } else if (nread > (int)buffer.size()) {
       /* no luck... a large datagram arrived and we truncated it.. now it is too late */
       buffer.clear();
     } else {
@@ -273,9 +307,97 @@ struct UdpSocket {
     return true;
   }
 
-  void *packetData() { return buffer.empty() ? 0 : &buffer[0]; }
-  size_t packetSize() { return buffer.size(); }
+  void *packetData() { 
+    if (ring_slot_count) return ring_packet_size ? ring_packet : 0;
+    return buffer.empty() ? 0 : &buffer[0]; 
+  }
+  size_t packetSize() { return ring_slot_count ? ring_packet_size : buffer.size(); }
+
+  /** zero-copy mode for receiveNextPacket: datagrams are read straight
+      into the next of slot_count preallocated slots of MAX_DATAGRAM_SIZE
+      bytes, and packetData() points into that slot instead of a freshly
+      allocated copy, so receiving does not touch the heap. The data of a
+      packet stays valid until slot_count-1 further packets have been
+      received, which lets a PacketReader (or another thread) keep
+      working on it meanwhile. slot_count = 0 goes back to the default
+      copying mode.
+  */
+  void enableReceiveRing(int slot_count) {
+    ring_buffer.clear();
+    if (slot_count > 0) ring_buffer.resize((size_t)slot_count * MAX_DATAGRAM_SIZE);
+    ring_slot_count = slot_count > 0 ? slot_count : 0;
+    ring_next_slot = 0; ring_packet = 0; ring_packet_size = 0;
+  }
   SockAddr &packetOrigin() { return remote_addr; }
+
+  /** batch variant of receiveNextPacket: waits for a datagram the same
+      way, then reads up to max_packets datagrams that are already
+      queued, with a single recvmmsg call on linux. Returns the number of
+      packets received, 0 in case of failure or timeout.
+
+      The packets are available with the batchPacketData(i) /
+      batchPacketSize(i) / batchPacketOrigin(i) functions until the next
+      call.
+  */
+  int receiveNextPackets(int max_packets, int timeout_ms = -1) {
+    batch_size = 0;
+    if (!isOk() || handle == -1) { setErr("not opened.."); return 0; }
+    if (max_packets <= 0) return 0;
+#ifdef OSCPKT_HAVE_MMSG
+    if (max_packets > 64) max_packets = 64;
+    batch_buffer.resize((size_t)max_packets * MAX_DATAGRAM_SIZE);
+    batch_sizes.resize(max_packets);
+    batch_origins.resize(max_packets);
+
+    if (timeout_ms >= 0 && !waitForData(timeout_ms)) return 0;
+
+    struct mmsghdr msgs[64];
+    struct iovec iov[64];
+    memset(msgs, 0, sizeof msgs[0] * max_packets);
+    for (int i=0; i < max_packets; ++i) {
+      iov[i].iov_base = &batch_buffer[(size_t)i * MAX_DATAGRAM_SIZE];
+      iov[i].iov_len = MAX_DATAGRAM_SIZE;
+      msgs[i].msg_hdr.msg_iov = &iov[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+      msgs[i].msg_hdr.msg_name = &batch_origins[i].addr();
+      msgs[i].msg_hdr.msg_namelen = (socklen_t)batch_origins[i].maxLen();
+    }
+    /* MSG_WAITFORONE: only the first datagram may block */
+    int nread = recvmmsg(handle, msgs, max_packets, MSG_WAITFORONE, 0);
+    if (nread < 0) {
+      if (errno != EAGAIN && errno != EINTR && errno != EWOULDBLOCK &&
+          errno != ECONNRESET && errno != ECONNREFUSED) {
+        setErr(strerror(errno));
+      }
+      if (!isOk()) close();
+      return 0;
+    }
+    for (int i=0; i < nread; ++i) {
+      /* a truncated datagram is dropped, as in receiveNextPacket */
+      batch_sizes[i] = (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) ? 0 : msgs[i].msg_len;
+    }
+    if (nread > 0) remote_addr = batch_origins[nread-1];
+    batch_size = nread;
+#else
+    if (!receiveNextPacket(timeout_ms)) return 0;
+    batch_buffer.assign((char*)packetData(), (char*)packetData() + packetSize());
+    batch_sizes.assign(1, packetSize());
+    batch_origins.assign(1, remote_addr);
+    batch_size = 1;
+#endif
+    return batch_size;
+  }
+
+  int batchSize() const { return batch_size; }
+  void *batchPacketData(int i) { 
+#ifdef OSCPKT_HAVE_MMSG
+    return batch_sizes[i] ? &batch_buffer[(size_t)i * MAX_DATAGRAM_SIZE] : 0; 
+#else
+    return batch_sizes[i] ? &batch_buffer[0] : 0;
+#endif
+  }
+  size_t batchPacketSize(int i) const { return batch_sizes[i]; }
+  SockAddr &batchPacketOrigin(int i) { return batch_origins[i]; }
   
 
   bool sendPacket(const void *ptr, size_t sz) {
@@ -308,7 +430,71 @@ struct UdpSocket {
     return (size_t)sent == sz;
   }
 
+  /** copy a packet into the send queue, it is sent by the next
+      flushQueuedPackets() */
+  void queuePacket(const void *ptr, size_t sz) {
+    const char *p = (const char*)ptr;
+    send_queue.insert(send_queue.end(), p, p + sz);
+    send_queue_sizes.push_back(sz);
+  }
+
+  size_t queuedPacketCount() const { return send_queue_sizes.size(); }
+
+  /** send every queued packet to the connected peer, with as few
+      sendmmsg calls as possible on linux. The queue is emptied in any
+      case, returns false if some packets could not be sent. */
+  bool flushQueuedPackets() {
+    bool ok = true;
+    if (!isOk() || handle == -1) { setErr("not opened.."); ok = false; }
+#ifdef OSCPKT_HAVE_MMSG
+    size_t offset = 0, sent = 0, count = send_queue_sizes.size();
+    while (ok && sent < count) {
+      struct mmsghdr msgs[64];
+      struct iovec iov[64];
+      unsigned n = (unsigned)std::min<size_t>(64, count - sent);
+      memset(msgs, 0, sizeof msgs[0] * n);
+      size_t o = offset;
+      for (unsigned i=0; i < n; ++i) {
+        iov[i].iov_base = &send_queue[o];
+        iov[i].iov_len = send_queue_sizes[sent + i];
+        o += send_queue_sizes[sent + i];
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        if (isBound()) {
+          msgs[i].msg_hdr.msg_name = &remote_addr.addr();
+          msgs[i].msg_hdr.msg_namelen = (socklen_t)remote_addr.actualLen();
+        }
+      }
+      int res = sendmmsg(handle, msgs, n, 0);
+      if (res == -1 && errno == EINTR) continue;
+      if (res <= 0) { ok = false; break; }
+      for (int i=0; i < res; ++i) offset += send_queue_sizes[sent + i];
+      sent += res;
+    }
+#else
+    size_t offset = 0;
+    for (size_t i=0; ok && i < send_queue_sizes.size(); ++i) {
+      ok = sendPacket(&send_queue[offset], send_queue_sizes[i]);
+      offset += send_queue_sizes[i];
+    }
+#endif
+    send_queue.clear();
+    send_queue_sizes.clear();
+    return ok;
+  }
+
 private:
+  /* select() on the socket, returns false on timeout or error */
+  bool waitForData(int timeout_ms) {
+    struct timeval tv; memset(&tv, 0, sizeof tv);
+    tv.tv_sec=timeout_ms/1000;
+    tv.tv_usec=(timeout_ms%1000) * 1000;
+    fd_set readset;
+    FD_ZERO(&readset);
+    FD_SET(handle, &readset);
+    return select( handle+1, &readset, 0, 0, &tv ) > 0;
+  }
+
   bool openSocket(const std::string &hostname, int port, int options) {
     char port_string[64]; 
 #ifdef _MSC_VER